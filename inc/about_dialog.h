@@ -1,61 +1,61 @@
-/** @file
-  * @copyright Copyright (c) 2013 PROFACTOR GmbH. All rights reserved. 
-  *
-  * Redistribution and use in source and binary forms, with or without
-  * modification, are permitted provided that the following conditions are
-  * met:
-  *
-  *     * Redistributions of source code must retain the above copyright
-  * notice, this list of conditions and the following disclaimer.
-  *     * Redistributions in binary form must reproduce the above
-  * copyright notice, this list of conditions and the following disclaimer
-  * in the documentation and/or other materials provided with the
-  * distribution.
-  *     * Neither the name of Profactor GmbH nor the names of its
-  * contributors may be used to endorse or promote products derived from
-  * this software without specific prior written permission.
-  *
-  * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
-  * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
-  * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
-  * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
-  * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
-  * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
-  * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
-  * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
-  * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
-  * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
-  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
-  *
-  * @authors christoph.kopf@profactor.at
-  *          florian.eckerstorfer@profactor.at
-  */
-  
-#ifndef ABOUT_DIALOG_H
-#define ABOUT_DIALOG_H
-
-#pragma once
-#include <QDialog>
-
-// Forward Declaration
-namespace Ui {
-  class about_dialog;
-}
-
-namespace ReconstructMeGUI {
-  /** This dialog shows the application about information*/
-  class about_dialog : public QDialog
-  {
-
-  public:
-    about_dialog(QWidget *parent = 0, Qt::WindowFlags f = 0);
-    ~about_dialog();
-  
-  private:
-    // Members
-    Ui::about_dialog *_ui;
-  };
-
-}
-
-#endif // ABOUT_DIALOG_H
+/** @file
+  * @copyright Copyright (c) 2013 PROFACTOR GmbH. All rights reserved. 
+  *
+  * Redistribution and use in source and binary forms, with or without
+  * modification, are permitted provided that the following conditions are
+  * met:
+  *
+  *     * Redistributions of source code must retain the above copyright
+  * notice, this list of conditions and the following disclaimer.
+  *     * Redistributions in binary form must reproduce the above
+  * copyright notice, this list of conditions and the following disclaimer
+  * in the documentation and/or other materials provided with the
+  * distribution.
+  *     * Neither the name of Profactor GmbH nor the names of its
+  * contributors may be used to endorse or promote products derived from
+  * this software without specific prior written permission.
+  *
+  * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  *
+  * @authors christoph.kopf@profactor.at
+  *          florian.eckerstorfer@profactor.at
+  */
+  
+#ifndef ABOUT_DIALOG_H
+#define ABOUT_DIALOG_H
+
+#pragma once
+#include <QDialog>
+
+// Forward Declaration
+namespace Ui {
+  class about_dialog;
+}
+
+namespace ReconstructMeGUI {
+  /** This dialog shows the application about information*/
+  class about_dialog : public QDialog
+  {
+
+  public:
+    about_dialog(QWidget *parent = 0, Qt::WindowFlags f = 0);
+    ~about_dialog();
+  
+  private:
+    // Members
+    Ui::about_dialog *_ui;
+  };
+
+}
+
+#endif // ABOUT_DIALOG_H
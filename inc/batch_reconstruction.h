@@ -0,0 +1,134 @@
+/** @file
+  * @copyright Copyright (c) 2013 PROFACTOR GmbH. All rights reserved. 
+  *
+  * Redistribution and use in source and binary forms, with or without
+  * modification, are permitted provided that the following conditions are
+  * met:
+  *
+  *     * Redistributions of source code must retain the above copyright
+  * notice, this list of conditions and the following disclaimer.
+  *     * Redistributions in binary form must reproduce the above
+  * copyright notice, this list of conditions and the following disclaimer
+  * in the documentation and/or other materials provided with the
+  * distribution.
+  *     * Neither the name of Profactor GmbH nor the names of its
+  * contributors may be used to endorse or promote products derived from
+  * this software without specific prior written permission.
+  *
+  * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  *
+  * @authors christoph.kopf@profactor.at
+  *          florian.eckerstorfer@profactor.at
+  */
+
+#ifndef BATCH_RECONSTRUCTION_H
+#define BATCH_RECONSTRUCTION_H
+
+#pragma once
+
+#include "types.h"
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QElapsedTimer>
+
+#include <memory>
+
+#include <reconstructmesdk/types.h>
+
+namespace ReconstructMeGUI {
+  class reme_resource_manager;
+  class frame_grabber;
+}
+
+namespace ReconstructMeGUI {
+
+  /** Escapes a string for use inside a quoted JSON value of a report */
+  QString json_escape(const QString &s);
+
+  /** Options of a headless reconstruction run */
+  struct batch_options {
+    batch_options();
+
+    QString name;           ///< Prefix for console output, may be empty
+    QString sensor_path;    ///< Sensor configuration or recording (.rmrec)
+    QString config_path;    ///< Reconstruction configuration, empty for default
+    QString license_path;   ///< License file, empty for non-commercial mode
+    QString output_path;    ///< Mesh file to write
+    QString report_path;    ///< JSON statistics file, empty to skip
+    int device_id;          ///< OpenCL device, -1 for automatic selection
+    float decimation;       ///< Fraction of faces to keep, 1 keeps all
+    int max_frames;         ///< Stop after this many frames, 0 for all
+    bool realtime;          ///< Pace replayed frames by their timestamps
+
+    /** Parse command line arguments of the form --name value. */
+    static bool parse(const QStringList &args, batch_options &o, QString &error);
+    /** True if the command line requests a headless run */
+    static bool requested(const QStringList &args);
+    static const char *usage();
+  };
+
+  /** Runs initialize, scan, generate_surface and save of reme_resource_manager without any widgets
+   *
+   *  Scanning ends when the replayed recording is exhausted, the sensor fails or 
+   *  max_frames frames were processed. The mesh and an optional JSON report are 
+   *  written and the application event loop is left with exit code 0 on success.
+   */
+  class batch_reconstruction : public QObject
+  {
+    Q_OBJECT;
+
+  public:
+    batch_reconstruction(const batch_options &o, QObject *parent = 0);
+    ~batch_reconstruction();
+
+    bool succeeded() const;
+    int num_frames() const;
+    qint64 scan_ms() const;
+
+  public slots:
+    void run();
+
+  private slots:
+    void sdk_initialized(bool success);
+    void frame_processed();
+    void grabbing_stopped();
+    void surface(bool has_surface,
+      const float *points, int num_points,
+      const float *normals, int num_normals,
+      const unsigned *faces, int num_faces);
+    void log_message(reme_log_severity_t sev, const QString &log);
+
+  signals:
+    void finished(int exit_code);
+
+  private:
+    void finish(bool success, const QString &message);
+    QString prefix() const;
+    bool write_report(const QString &message) const;
+
+    batch_options _o;
+    std::shared_ptr<reme_resource_manager> _rm;
+    std::shared_ptr<frame_grabber> _fg;
+
+    QElapsedTimer _clock;
+    qint64 _init_ms, _scan_ms, _surface_ms, _save_ms;
+    int _num_frames;
+    int _num_points, _num_faces;
+    bool _initialized, _has_surface, _saved, _success;
+    QStringList _errors;
+  };
+}
+
+#endif // BATCH_RECONSTRUCTION_H
@@ -0,0 +1,135 @@
+/** @file
+  * @copyright Copyright (c) 2013 PROFACTOR GmbH. All rights reserved. 
+  *
+  * Redistribution and use in source and binary forms, with or without
+  * modification, are permitted provided that the following conditions are
+  * met:
+  *
+  *     * Redistributions of source code must retain the above copyright
+  * notice, this list of conditions and the following disclaimer.
+  *     * Redistributions in binary form must reproduce the above
+  * copyright notice, this list of conditions and the following disclaimer
+  * in the documentation and/or other materials provided with the
+  * distribution.
+  *     * Neither the name of Profactor GmbH nor the names of its
+  * contributors may be used to endorse or promote products derived from
+  * this software without specific prior written permission.
+  *
+  * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  *
+  * @authors christoph.kopf@profactor.at
+  *          florian.eckerstorfer@profactor.at
+  */
+
+#ifndef BATCH_SCHEDULER_H
+#define BATCH_SCHEDULER_H
+
+#pragma once
+
+#include "batch_reconstruction.h"
+
+#include <QObject>
+#include <QList>
+#include <QStringList>
+#include <QElapsedTimer>
+
+#include <memory>
+
+class QThread;
+
+namespace ReconstructMeGUI {
+
+  /** Runs several headless reconstructions concurrently
+   *
+   *  Jobs are read from an INI manifest. The [general] group holds the pool 
+   *  configuration, every other group describes one job using the keys of 
+   *  the --batch command line (sensor, config, license, output, report, 
+   *  device, decimation, frames).
+   *
+   *  \code
+   *  [general]
+   *  jobs=4
+   *  memory_budget_mb=3072
+   *  bytes_per_voxel=4
+   *  report=pool.json
+   *
+   *  [customer_0815]
+   *  sensor=recordings/customer_0815.rmrec
+   *  config=cfg/highres.txt
+   *  output=meshes/customer_0815.ply
+   *  \endcode
+   *
+   *  Each job owns its context, volume and sensor on a thread of its own. Jobs
+   *  are started in order of decreasing cost (volume resolution times frame 
+   *  count) as long as the number of running jobs and the sum of their 
+   *  estimated volume allocations stay within the configured limits.
+   */
+  class batch_scheduler : public QObject
+  {
+    Q_OBJECT;
+
+  public:
+    batch_scheduler(QObject *parent = 0);
+    ~batch_scheduler();
+
+    bool load_manifest(const QString &file_name, QString &error);
+    bool succeeded() const;
+
+    /** True if the command line requests a manifest run, sets the manifest path */
+    static bool requested(const QStringList &args, QString &manifest);
+
+  public slots:
+    void run();
+
+  signals:
+    void finished(int exit_code);
+
+  private slots:
+    void job_finished(int exit_code);
+
+  private:
+    struct job {
+      batch_options options;
+      qint64 volume_bytes;
+      int num_frames;
+      double cost;
+
+      QThread *thread;
+      batch_reconstruction *worker;
+      bool success;
+      int frames_processed;
+      qint64 scan_ms;
+    };
+    typedef std::shared_ptr<job> job_ptr;
+
+    void schedule();
+    void finish();
+    bool write_report() const;
+    static qint64 estimate_volume_bytes(const QString &config_path, int bytes_per_voxel);
+
+    QList<job_ptr> _pending;
+    QList<job_ptr> _running;
+    QList<job_ptr> _done;
+
+    int _max_jobs;
+    qint64 _memory_budget;
+    qint64 _memory_used;
+    int _bytes_per_voxel;
+    QString _report_path;
+
+    QElapsedTimer _clock;
+    bool _success;
+  };
+}
+
+#endif // BATCH_SCHEDULER_H
@@ -0,0 +1,74 @@
+/** @file
+  * @copyright Copyright (c) 2013 PROFACTOR GmbH. All rights reserved. 
+  *
+  * Redistribution and use in source and binary forms, with or without
+  * modification, are permitted provided that the following conditions are
+  * met:
+  *
+  *     * Redistributions of source code must retain the above copyright
+  * notice, this list of conditions and the following disclaimer.
+  *     * Redistributions in binary form must reproduce the above
+  * copyright notice, this list of conditions and the following disclaimer
+  * in the documentation and/or other materials provided with the
+  * distribution.
+  *     * Neither the name of Profactor GmbH nor the names of its
+  * contributors may be used to endorse or promote products derived from
+  * this software without specific prior written permission.
+  *
+  * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  *
+  * @authors christoph.kopf@profactor.at
+  *          florian.eckerstorfer@profactor.at
+  */
+
+#ifndef CONFIG_OPTIONS_H
+#define CONFIG_OPTIONS_H
+
+#pragma once
+
+#include <QMap>
+#include <QString>
+#include <QStringList>
+
+namespace ReconstructMeGUI {
+
+  /** Flattened view of a reconstruction options file.
+   *
+   *  Configuration files are protobuf text format. Parsing yields one entry
+   *  per scalar field keyed by its dotted path, such as 
+   *  volume.minimum_corner.x. Repeated occurrences of a path are suffixed 
+   *  with their index in brackets. Comparing two parses tells which options 
+   *  changed between two versions of a file.
+   */
+  namespace config_options {
+    typedef QMap<QString, QString> values_t;
+
+    /** Parses text format, returns false and an error description on malformed input */
+    bool parse(const QString &text, values_t &values, QString &error);
+    bool parse_file(const QString &path, values_t &values, QString &error);
+
+    /** Sets the given paths in text, keeping comments and layout. Paths not present are appended. */
+    bool rewrite(QString &text, const values_t &changes, QString &error);
+
+    /** Paths added, removed or changed from a to b */
+    QStringList diff(const values_t &a, const values_t &b);
+
+    /** True if the option can be changed on a compiled context without recompiling */
+    bool is_live(const QString &path);
+
+    /** Value as expected by reme_options_set, strips the quotes of string values */
+    QString unquote(const QString &value);
+  }
+}
+
+#endif
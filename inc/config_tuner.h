@@ -0,0 +1,88 @@
+/** @file
+  * @copyright Copyright (c) 2013 PROFACTOR GmbH. All rights reserved. 
+  *
+  * Redistribution and use in source and binary forms, with or without
+  * modification, are permitted provided that the following conditions are
+  * met:
+  *
+  *     * Redistributions of source code must retain the above copyright
+  * notice, this list of conditions and the following disclaimer.
+  *     * Redistributions in binary form must reproduce the above
+  * copyright notice, this list of conditions and the following disclaimer
+  * in the documentation and/or other materials provided with the
+  * distribution.
+  *     * Neither the name of Profactor GmbH nor the names of its
+  * contributors may be used to endorse or promote products derived from
+  * this software without specific prior written permission.
+  *
+  * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  *
+  * @authors christoph.kopf@profactor.at
+  *          florian.eckerstorfer@profactor.at
+  */
+
+#ifndef CONFIG_TUNER_H
+#define CONFIG_TUNER_H
+
+#pragma once
+
+#include <QString>
+#include <QVector>
+#include <QByteArray>
+
+namespace ReconstructMeGUI {
+
+  /** Finds the highest volume resolution that sustains a target frame rate.
+   *
+   *  A short capture of raw depth frames is replayed through an external 
+   *  sensor once per candidate resolution, each in a context compiled for
+   *  the selected device. Candidates scale the resolution of the base config
+   *  and keep its volume extents. Candidates are measured in increasing order 
+   *  until one misses the target or can not be created.
+   */
+  class config_tuner {
+  public:
+    struct candidate {
+      candidate() : x(0), y(0), z(0), fps(-1.f), volume_mb(0) {}
+
+      int x, y, z;
+      float fps;        ///< Sustained frames per second, negative if the candidate failed
+      int volume_mb;    ///< Estimated device memory of the volume
+    };
+
+    config_tuner(const QString &config_path, int device_id);
+
+    /** Raw depth frames to replay, all frames have to be of the given size */
+    void set_frame_size(int width, int height);
+    void add_frame(const QByteArray &raw_depth);
+    int num_frames() const;
+
+    /** Measures the candidates, returns the best one meeting target_fps or a candidate with x = 0 */
+    candidate tune(float target_fps, QVector<candidate> &measured) const;
+
+    /** Writes the base config with the resolution of c to path */
+    static bool write(const QString &config_path, const candidate &c, const QString &path, QString &error);
+
+  private:
+    /** Resolution of the base config, falls back to the SDK defaults */
+    bool base_resolution(int &x, int &y, int &z) const;
+    void measure(candidate &c) const;
+
+    QString _config_path;
+    int _device_id;
+    int _width, _height;
+    QVector<QByteArray> _frames;
+  };
+}
+
+#endif
@@ -0,0 +1,82 @@
+/** @file
+  * @copyright Copyright (c) 2013 PROFACTOR GmbH. All rights reserved. 
+  *
+  * Redistribution and use in source and binary forms, with or without
+  * modification, are permitted provided that the following conditions are
+  * met:
+  *
+  *     * Redistributions of source code must retain the above copyright
+  * notice, this list of conditions and the following disclaimer.
+  *     * Redistributions in binary form must reproduce the above
+  * copyright notice, this list of conditions and the following disclaimer
+  * in the documentation and/or other materials provided with the
+  * distribution.
+  *     * Neither the name of Profactor GmbH nor the names of its
+  * contributors may be used to endorse or promote products derived from
+  * this software without specific prior written permission.
+  *
+  * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  *
+  * @authors christoph.kopf@profactor.at
+  *          florian.eckerstorfer@profactor.at
+  */
+
+#ifndef DEVICE_PROFILE_H
+#define DEVICE_PROFILE_H
+
+#pragma once
+
+#include "opencl_info.pb.h"
+
+#include <QString>
+
+#include <reconstructmesdk/types.h>
+
+namespace ReconstructMeGUI {
+
+  /** Measured reconstruction throughput of the OpenCL devices of this machine.
+   *
+   *  Each device runs a short workload of volume integrations and raycasts
+   *  with the configured volume in a context of its own. Results are kept per
+   *  device name and volume resolution in an ini file next to the application 
+   *  settings and are dropped when the SDK version changes.
+   */
+  class device_profile {
+  public:
+    device_profile(const QString &path);
+
+    /** Profile file next to the application settings */
+    static QString default_path();
+    /** Volume resolution of the bound reconstruction options, such as 256x256x256 */
+    static QString volume_resolution(reme_context_t c, reme_options_t o);
+
+    /** Drops measurements taken with a different SDK version */
+    void validate(const QString &sdk_version);
+
+    /** Frames per second measured for the device, negative if it has not been profiled */
+    float fps(const QString &device_name, const QString &resolution) const;
+    void insert(const QString &device_name, const QString &resolution, float fps);
+    /** Index of the fastest device, -1 unless every device has been profiled */
+    int best_device(const opencl_info &ocl, const QString &resolution) const;
+
+    /** Runs the workload on device_id with the options of config_path. Returns frames per second, negative on failure. */
+    static float measure(int device_id, const QString &config_path, QString &resolution);
+
+  private:
+    static QString key(const QString &device_name, const QString &resolution);
+
+    QString _path;
+  };
+}
+
+#endif
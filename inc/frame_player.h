@@ -0,0 +1,116 @@
+/** @file
+  * @copyright Copyright (c) 2013 PROFACTOR GmbH. All rights reserved. 
+  *
+  * Redistribution and use in source and binary forms, with or without
+  * modification, are permitted provided that the following conditions are
+  * met:
+  *
+  *     * Redistributions of source code must retain the above copyright
+  * notice, this list of conditions and the following disclaimer.
+  *     * Redistributions in binary form must reproduce the above
+  * copyright notice, this list of conditions and the following disclaimer
+  * in the documentation and/or other materials provided with the
+  * distribution.
+  *     * Neither the name of Profactor GmbH nor the names of its
+  * contributors may be used to endorse or promote products derived from
+  * this software without specific prior written permission.
+  *
+  * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  *
+  * @authors christoph.kopf@profactor.at
+  *          florian.eckerstorfer@profactor.at
+  */
+
+#ifndef FRAME_PLAYER_H
+#define FRAME_PLAYER_H
+
+#pragma once
+
+#include "recording_format.h"
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QQueue>
+#include <QVector>
+#include <QFile>
+#include <QElapsedTimer>
+
+namespace ReconstructMeGUI {
+
+  /** Replays frames of a recording produced by frame_recorder.
+   *
+   *  The recording is memory-mapped and its index is read from the trailer, or
+   *  rebuilt by scanning the chunks if the recording was not closed properly. 
+   *  A prefetch thread decodes frames ahead of time into a small bounded queue.
+   *
+   *  In REALTIME mode next_frame paces the frames according to their recorded 
+   *  timestamps, in AS_FAST_AS_POSSIBLE mode frames are handed out as soon as 
+   *  they are decoded, which makes replay suitable for throughput measurements.
+   */
+  class frame_player : public QThread
+  {
+    Q_OBJECT;
+
+  public:
+    enum replay_mode_t { REALTIME, AS_FAST_AS_POSSIBLE };
+
+    frame_player(QObject *parent = 0);
+    ~frame_player();
+
+    /** Map the recording and start prefetching. */
+    bool open(const QString &file_name, replay_mode_t mode);
+    void close();
+
+    int num_frames() const;
+    /** Number of frames in a recording without starting playback, -1 if it cannot be read. */
+    static int count_frames(const QString &file_name);
+    const recording_header &header() const;
+
+    /** Size of the first recorded image of the given type. Returns false if there is no such image. */
+    bool image_size(int type, int &width, int &height) const;
+
+    /** Blocks until the next frame is available. Returns false at the end of the recording. */
+    bool next_frame(recording::frame &f);
+
+  protected:
+    virtual void run();
+
+  private:
+    bool load(const QString &file_name);
+    bool read_index();
+    bool rebuild_index();
+    bool read_chunk(qint64 offset, quint32 &type, const uchar *&payload, quint32 &size) const;
+    bool decode_frame(qint64 offset, recording::frame &f) const;
+
+    QFile _file;
+    const uchar *_map;
+    qint64 _map_size;
+
+    recording_header _header;
+    QVector<qint64> _offsets;
+    replay_mode_t _mode;
+
+    QMutex _mutex;
+    QWaitCondition _queue_not_empty;
+    QWaitCondition _queue_not_full;
+    QQueue<recording::frame> _queue;
+    bool _stop_requested;
+    bool _prefetch_done;
+
+    QElapsedTimer _clock;
+    qint64 _first_timestamp_us;
+  };
+}
+
+#endif // FRAME_PLAYER_H
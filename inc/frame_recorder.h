@@ -0,0 +1,120 @@
+/** @file
+  * @copyright Copyright (c) 2013 PROFACTOR GmbH. All rights reserved. 
+  *
+  * Redistribution and use in source and binary forms, with or without
+  * modification, are permitted provided that the following conditions are
+  * met:
+  *
+  *     * Redistributions of source code must retain the above copyright
+  * notice, this list of conditions and the following disclaimer.
+  *     * Redistributions in binary form must reproduce the above
+  * copyright notice, this list of conditions and the following disclaimer
+  * in the documentation and/or other materials provided with the
+  * distribution.
+  *     * Neither the name of Profactor GmbH nor the names of its
+  * contributors may be used to endorse or promote products derived from
+  * this software without specific prior written permission.
+  *
+  * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  *
+  * @authors christoph.kopf@profactor.at
+  *          florian.eckerstorfer@profactor.at
+  */
+
+#ifndef FRAME_RECORDER_H
+#define FRAME_RECORDER_H
+
+#pragma once
+
+#include "recording_format.h"
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QQueue>
+#include <QFile>
+#include <QElapsedTimer>
+
+#include <memory>
+
+#include <reconstructmesdk/types.h>
+
+namespace ReconstructMeGUI {
+
+  /** Streams grabbed frames to a chunked recording file.
+   *
+   *  The frame grabber hands each synchronized set of sensor images to the 
+   *  recorder, which copies the raw data into a bounded queue. Compression and 
+   *  disk I/O happen on the recorder's own thread. If the writer falls behind
+   *  and the queue exceeds its memory budget, frames are dropped instead of 
+   *  stalling the grabber.
+   *
+   *  \note begin_frame, add_image and add_pose are called from the grabbing thread.
+   *  \see recording_format.h for the file layout.
+   */
+  class frame_recorder : public QThread
+  {
+    Q_OBJECT;
+
+  public:
+    frame_recorder(QObject *parent = 0);
+    ~frame_recorder();
+
+    bool is_recording() const;
+
+    /** Marks the beginning of a new set of images. The previous set is queued for writing. */
+    void begin_frame();
+    /** Adds a copy of the image to the current set */
+    void add_image(reme_sensor_image_t type, const void *data, int length, int width, int height, int channels, int num_bytes_per_channel, int row_stride);
+    /** Attaches a 4x4 sensor pose to the current set */
+    void add_pose(const float *pose, bool track_success);
+
+  public slots:
+    bool start_recording(const QString &file_name);
+    void stop_recording();
+
+  signals:
+    void recording_started(const QString &file_name);
+    void recording_stopped(int num_frames, int num_dropped);
+
+  protected:
+    virtual void run();
+
+  private:
+    struct raw_frame : public recording::frame {
+      int num_bytes;
+    };
+
+    void enqueue_pending();
+    void write_chunk(recording::chunk_t type, const std::string &payload);
+    void write_frame(const raw_frame &f);
+
+    mutable QMutex _mutex;
+    QWaitCondition _queue_not_empty;
+    QQueue< std::shared_ptr<raw_frame> > _queue;
+    std::shared_ptr<raw_frame> _pending;
+    qint64 _queued_bytes;
+    qint64 _max_queued_bytes;
+    bool _recording;
+    bool _stop_requested;
+    bool _lossy_aux;
+
+    QElapsedTimer _clock;
+    QFile _file;
+    recording_index _index;
+    int _num_frames;
+    int _num_dropped;
+  };
+}
+
+#endif // FRAME_RECORDER_H
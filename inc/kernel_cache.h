@@ -0,0 +1,93 @@
+/** @file
+  * @copyright Copyright (c) 2013 PROFACTOR GmbH. All rights reserved. 
+  *
+  * Redistribution and use in source and binary forms, with or without
+  * modification, are permitted provided that the following conditions are
+  * met:
+  *
+  *     * Redistributions of source code must retain the above copyright
+  * notice, this list of conditions and the following disclaimer.
+  *     * Redistributions in binary form must reproduce the above
+  * copyright notice, this list of conditions and the following disclaimer
+  * in the documentation and/or other materials provided with the
+  * distribution.
+  *     * Neither the name of Profactor GmbH nor the names of its
+  * contributors may be used to endorse or promote products derived from
+  * this software without specific prior written permission.
+  *
+  * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  *
+  * @authors christoph.kopf@profactor.at
+  *          florian.eckerstorfer@profactor.at
+  */
+
+#ifndef KERNEL_CACHE_H
+#define KERNEL_CACHE_H
+
+#pragma once
+
+#include <QString>
+#include <QByteArray>
+#include <QStringList>
+
+namespace ReconstructMeGUI {
+
+  /** Persistent cache of compiled OpenCL kernels.
+   *
+   *  The SDK does not expose program binaries, so the cache directory is handed
+   *  to the OpenCL runtimes, which store compiled programs there themselves. 
+   *  A manifest next to the binaries records which configurations have been 
+   *  compiled, together with size and checksum of the binaries each 
+   *  compilation added. Entries are verified before they are reported as 
+   *  hits and dropped with their binaries if they no longer match. Other 
+   *  files in the directory are left to the runtimes. The cache is wiped 
+   *  when the SDK version changes.
+   *
+   *  \note export_environment modifies the process environment. It has to be 
+   *  called once from main, before the first context is created and before 
+   *  any other thread starts.
+   */
+  class kernel_cache {
+  public:
+    kernel_cache(const QString &root);
+
+    /** Cache directory next to the application settings */
+    static QString default_root();
+    /** Identifies a compiled configuration */
+    static QString make_key(int device_id, const QString &device_name, const QString &driver_version, const QString &sdk_version, const QByteArray &options);
+
+    const QString &root() const;
+
+    /** Points the OpenCL runtime caches to this directory, unless set by the user */
+    void export_environment() const;
+    /** Wipes the cache if it was built by a different SDK version. Returns false if the cache was wiped. */
+    bool validate(const QString &sdk_version);
+
+    /** Cached files relative to root, taken before a compilation */
+    QStringList files() const;
+    /** True if key has been compiled before and its binaries are intact. Drops the entry otherwise. */
+    bool contains(const QString &key);
+    /** Records a successful compilation with the binaries it added since before */
+    void insert(const QString &key, int compile_msecs, const QStringList &before);
+    /** Compile time recorded for key on its first, uncached compilation */
+    int cold_msecs(const QString &key) const;
+
+  private:
+    QString manifest_path() const;
+    void clear();
+
+    QString _root;
+  };
+}
+
+#endif
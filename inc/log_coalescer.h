@@ -0,0 +1,105 @@
+/** @file
+  * @copyright Copyright (c) 2013 PROFACTOR GmbH. All rights reserved. 
+  *
+  * Redistribution and use in source and binary forms, with or without
+  * modification, are permitted provided that the following conditions are
+  * met:
+  *
+  *     * Redistributions of source code must retain the above copyright
+  * notice, this list of conditions and the following disclaimer.
+  *     * Redistributions in binary form must reproduce the above
+  * copyright notice, this list of conditions and the following disclaimer
+  * in the documentation and/or other materials provided with the
+  * distribution.
+  *     * Neither the name of Profactor GmbH nor the names of its
+  * contributors may be used to endorse or promote products derived from
+  * this software without specific prior written permission.
+  *
+  * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  *
+  * @authors christoph.kopf@profactor.at
+  *          florian.eckerstorfer@profactor.at
+  */
+
+#ifndef LOG_COALESCER_H
+#define LOG_COALESCER_H
+
+#pragma once
+
+#include <QString>
+#include <QVector>
+
+#include <reconstructmesdk/types.h>
+
+namespace ReconstructMeGUI {
+
+  /** Log message as passed on after coalescing */
+  struct log_record {
+    reme_log_severity_t sev;
+    QString message;
+    /** Number of identical messages represented, more than one for collapsed runs */
+    int count;
+    /** Times of the first and last message represented in microseconds */
+    qint64 first_us, last_us;
+  };
+
+  /** Collapses log floods before they reach the log sink and the GUI.
+   *
+   *  Identical consecutive messages are passed on once, further repeats are 
+   *  counted and reported as a single record when the run ends or flush is 
+   *  called. New messages are limited per severity by a token bucket, messages 
+   *  beyond the limit are counted and reported as a single suppression notice.
+   *  Work downstream is therefore bounded per flush interval no matter how 
+   *  many messages are logged.
+   */
+  class log_coalescer {
+  public:
+    log_coalescer();
+
+    /** Allows burst messages at once and rate_per_sec messages on average */
+    void set_limit(reme_log_severity_t sev, double rate_per_sec, int burst);
+
+    /** Feeds a message, appends the records to pass on to out */
+    void add(reme_log_severity_t sev, const QString &message, qint64 now_us, QVector<log_record> &out);
+    /** Reports pending repeats and suppressed messages */
+    void flush(qint64 now_us, QVector<log_record> &out);
+
+  private:
+    struct bucket {
+      double rate_per_us;
+      double burst;
+      double tokens;
+      qint64 last_us;
+      int suppressed;
+      qint64 first_suppressed_us, last_suppressed_us;
+    };
+
+    static int bucket_index(reme_log_severity_t sev);
+    bool take(bucket &b, qint64 now_us);
+    void suppress(bucket &b, qint64 now_us);
+    void end_run(QVector<log_record> &out);
+    void report_suppressed(reme_log_severity_t sev, bucket &b, QVector<log_record> &out);
+
+    bucket _buckets[3];
+
+    bool _has_run;
+    /** False if the first message of the run was suppressed */
+    bool _run_passed;
+    reme_log_severity_t _run_sev;
+    QString _run_message;
+    int _run_repeats;
+    qint64 _run_first_us, _run_last_us;
+  };
+}
+
+#endif
@@ -0,0 +1,121 @@
+/** @file
+  * @copyright Copyright (c) 2013 PROFACTOR GmbH. All rights reserved. 
+  *
+  * Redistribution and use in source and binary forms, with or without
+  * modification, are permitted provided that the following conditions are
+  * met:
+  *
+  *     * Redistributions of source code must retain the above copyright
+  * notice, this list of conditions and the following disclaimer.
+  *     * Redistributions in binary form must reproduce the above
+  * copyright notice, this list of conditions and the following disclaimer
+  * in the documentation and/or other materials provided with the
+  * distribution.
+  *     * Neither the name of Profactor GmbH nor the names of its
+  * contributors may be used to endorse or promote products derived from
+  * this software without specific prior written permission.
+  *
+  * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  *
+  * @authors christoph.kopf@profactor.at
+  *          florian.eckerstorfer@profactor.at
+  */
+
+#ifndef LOG_FILE_MODEL_H
+#define LOG_FILE_MODEL_H
+
+#pragma once
+
+#include "log.pb.h"
+
+#include <QAbstractTableModel>
+#include <QFile>
+#include <QFuture>
+#include <QMutex>
+#include <QAtomicInt>
+#include <QVector>
+#include <QCache>
+#include <QTimer>
+#include <QIcon>
+
+namespace ReconstructMeGUI {
+
+  /** Read-only table model of a saved or streamed log file.
+   *
+   *  Both saved logs and the files written by log_sink are serialized 
+   *  logging_info messages, that is a sequence of length-delimited log_entry
+   *  records. The file is memory-mapped and the offsets of its records are 
+   *  collected on a background thread, rows become available as indexing 
+   *  proceeds. Records are decoded when the view asks for them and a limited 
+   *  number of decoded records is cached. A truncated record at the end of 
+   *  a file, as left by a crash, ends the log.
+   */
+  class log_file_model : public QAbstractTableModel
+  {
+    Q_OBJECT;
+
+  public:
+    log_file_model(QObject *parent = 0);
+    ~log_file_model();
+
+    /** Maps path and starts indexing it, returns false if it cannot be mapped */
+    bool open(const QString &path);
+    void close();
+
+    QString path() const;
+    /** True while records are being indexed */
+    bool indexing() const;
+
+    virtual int rowCount(const QModelIndex &parent = QModelIndex()) const;
+    virtual int columnCount(const QModelIndex &parent = QModelIndex()) const;
+    virtual QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const;
+    virtual QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const;
+
+  signals:
+    /** Emitted when indexing finished with the number of records found */
+    void indexed(int num_records);
+
+  private slots:
+    /** Makes records indexed so far available to the view */
+    void publish();
+
+  private:
+    struct record {
+      qint64 offset;
+      int size;
+    };
+
+    void index_records();
+    const logging_info_log_entry *decode(int row) const;
+
+    QFile _file;
+    const uchar *_data;
+    qint64 _size;
+
+    QFuture<void> _indexer;
+    QAtomicInt _cancel;
+    QAtomicInt _done;
+
+    /** Records found by the indexer, guarded by _mutex */
+    QVector<record> _found;
+    mutable QMutex _mutex;
+    /** Records visible to the view, owned by the GUI thread */
+    QVector<record> _records;
+
+    QTimer _publish_timer;
+    mutable QCache<int, logging_info_log_entry> _decoded;
+    mutable QIcon _icons[3];
+  };
+}
+
+#endif
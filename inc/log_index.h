@@ -0,0 +1,122 @@
+/** @file
+  * @copyright Copyright (c) 2013 PROFACTOR GmbH. All rights reserved. 
+  *
+  * Redistribution and use in source and binary forms, with or without
+  * modification, are permitted provided that the following conditions are
+  * met:
+  *
+  *     * Redistributions of source code must retain the above copyright
+  * notice, this list of conditions and the following disclaimer.
+  *     * Redistributions in binary form must reproduce the above
+  * copyright notice, this list of conditions and the following disclaimer
+  * in the documentation and/or other materials provided with the
+  * distribution.
+  *     * Neither the name of Profactor GmbH nor the names of its
+  * contributors may be used to endorse or promote products derived from
+  * this software without specific prior written permission.
+  *
+  * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  *
+  * @authors christoph.kopf@profactor.at
+  *          florian.eckerstorfer@profactor.at
+  */
+
+#ifndef LOG_INDEX_H
+#define LOG_INDEX_H
+
+#pragma once
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QHash>
+
+#include <reconstructmesdk/types.h>
+
+namespace ReconstructMeGUI {
+
+  /** Incrementally maintained search index over log entries.
+   *
+   *  Entries are identified by consecutive sequence numbers and added in 
+   *  chronological order. The index keeps per-severity entry lists, the 
+   *  timestamp of every entry and an inverted index from lower case word 
+   *  tokens to entries. Time ranges map to sequence ranges by binary search,
+   *  substring queries intersect the entries of all tokens containing the 
+   *  query words and are verified against the message text afterwards.
+   *  Entries dropped at the front are removed lazily.
+   */
+  class log_index {
+  public:
+    /** Access to the text of indexed entries */
+    class source {
+    public:
+      virtual ~source() {}
+      virtual QString message(qint64 seq) const = 0;
+    };
+
+    enum severity_mask_t {
+      INFO_MASK = 1,
+      WARNING_MASK = 2,
+      ERROR_MASK = 4,
+      ALL_MASK = 7
+    };
+
+    struct query {
+      query();
+      bool is_empty() const;
+
+      int severities;
+      qint64 from_msecs, to_msecs;
+      /** Case insensitive substring of the message */
+      QString text;
+    };
+
+    log_index();
+
+    static int severity_mask(reme_log_severity_t sev);
+    /** Lower case word tokens of text */
+    static QStringList tokenize(const QString &text);
+
+    /** Indexes the entry following the last one added */
+    void add(reme_log_severity_t sev, qint64 msecs, const QString &message);
+    /** Drops entries before seq */
+    void drop_before(qint64 seq);
+    /** Removes all entries, sequence numbers continue */
+    void clear();
+
+    qint64 first_seq() const;
+    qint64 end_seq() const;
+
+    /** Sequence numbers of matching entries in ascending order */
+    QVector<qint64> search(const query &q, const source &src) const;
+    /** True if the entry seq matches q */
+    bool matches(const query &q, qint64 seq, const source &src) const;
+
+  private:
+    /** Position of seq in the per-entry vectors */
+    int pos(qint64 seq) const { return (int)(seq - _base_seq); }
+    void compact();
+
+    /** Sequence number of the first element of the per-entry vectors */
+    qint64 _base_seq;
+    qint64 _first_seq;
+    qint64 _end_seq;
+
+    QVector<qint64> _msecs;
+    QVector<char> _sev;
+    QVector<qint64> _by_severity[3];
+    QHash<QString, QVector<qint64> > _postings;
+  };
+}
+
+#endif
@@ -0,0 +1,168 @@
+/** @file
+  * @copyright Copyright (c) 2013 PROFACTOR GmbH. All rights reserved. 
+  *
+  * Redistribution and use in source and binary forms, with or without
+  * modification, are permitted provided that the following conditions are
+  * met:
+  *
+  *     * Redistributions of source code must retain the above copyright
+  * notice, this list of conditions and the following disclaimer.
+  *     * Redistributions in binary form must reproduce the above
+  * copyright notice, this list of conditions and the following disclaimer
+  * in the documentation and/or other materials provided with the
+  * distribution.
+  *     * Neither the name of Profactor GmbH nor the names of its
+  * contributors may be used to endorse or promote products derived from
+  * this software without specific prior written permission.
+  *
+  * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  *
+  * @authors christoph.kopf@profactor.at
+  *          florian.eckerstorfer@profactor.at
+  */
+
+#ifndef LOG_MODEL_H
+#define LOG_MODEL_H
+
+#pragma once
+
+#include "log_index.h"
+
+#include <QAbstractTableModel>
+#include <QVector>
+#include <QString>
+#include <QIcon>
+#include <QTimer>
+
+#include <reconstructmesdk/types.h>
+
+namespace ReconstructMeGUI {
+
+  /** Table model of log messages backed by a fixed-capacity ring buffer.
+   *
+   *  Messages are queued by append and inserted into the model in batches 
+   *  when the flush timer fires. Once the number of entries or the memory 
+   *  held by messages exceeds its limit, the oldest entries are dropped.
+   *  Sorting by other columns than the timestamp is computed on request 
+   *  only, later batches are appended unsorted until the next request.
+   *
+   *  Entries are indexed as they arrive. While a filter is set, rows show
+   *  the matching entries only and are handed to the view in pages.
+   */
+  class log_model : public QAbstractTableModel, private log_index::source
+  {
+    Q_OBJECT;
+
+  public:
+    enum column_t {
+      SEVERITY_COLUMN,
+      TIMESTAMP_COLUMN,
+      MESSAGE_COLUMN,
+      NUM_COLUMNS
+    };
+
+    struct entry {
+      reme_log_severity_t sev;
+      /** Milliseconds since epoch */
+      qint64 msecs;
+      QString message;
+      /** Number of identical messages collapsed into this entry */
+      int count;
+      /** Time of the last collapsed message */
+      qint64 last_msecs;
+    };
+
+    log_model(int capacity = 20000, qint64 max_bytes = 16 * 1024 * 1024, QObject *parent = 0);
+
+    /** Queues a message, it becomes visible with the next flush */
+    void append(reme_log_severity_t sev, const QString &message);
+    /** Queues count identical messages logged from first_msecs to last_msecs as one entry */
+    void append(reme_log_severity_t sev, const QString &message, int count, qint64 first_msecs, qint64 last_msecs);
+    void set_flush_interval(int msecs);
+
+    /** Shows only entries matching q, an empty query shows all */
+    void set_filter(const log_index::query &q);
+    const log_index::query &filter() const;
+    /** Number of entries matching the filter, including rows not fetched yet */
+    int num_matches() const;
+
+    /** Number of entries held, oldest first */
+    int size() const;
+    /** Entry by age, 0 is the oldest */
+    const entry &at(int i) const;
+    /** Entry shown in row */
+    const entry &at_row(int row) const;
+
+    static QString severity_text(reme_log_severity_t sev);
+
+    virtual int rowCount(const QModelIndex &parent = QModelIndex()) const;
+    virtual int columnCount(const QModelIndex &parent = QModelIndex()) const;
+    virtual QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const;
+    virtual QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const;
+    virtual void sort(int column, Qt::SortOrder order = Qt::AscendingOrder);
+    virtual bool canFetchMore(const QModelIndex &parent) const;
+    virtual void fetchMore(const QModelIndex &parent);
+
+  public slots:
+    /** Moves queued messages into the model */
+    void flush();
+    void clear();
+
+  signals:
+    /** Emitted after a batch of messages was inserted */
+    void flushed();
+
+  private:
+    virtual QString message(qint64 seq) const;
+
+    static qint64 bytes_of(const entry &e);
+    /** Sequence number of the entry shown in row */
+    qint64 seq_of_row(int row) const;
+    const entry &at_seq(qint64 seq) const;
+    void push(const entry &e);
+    void pop();
+    /** Recomputes the row mapping from filter and sort order */
+    void rebuild_rows();
+    void order_rows(QVector<qint64> &rows) const;
+    /** Updates the row mapping after a flush dropped entries and added n entries */
+    void update_rows(int n);
+
+    QVector<entry> _ring;
+    int _head;
+    int _count;
+    int _capacity;
+    /** Sequence number of the oldest entry */
+    qint64 _first_seq;
+    qint64 _bytes;
+    qint64 _max_bytes;
+
+    QVector<entry> _pending;
+    QTimer _flush_timer;
+
+    log_index _index;
+    log_index::query _filter;
+
+    bool _descending;
+    int _sort_column;
+    Qt::SortOrder _sort_order;
+    /** Rows are mapped through _rows while filtered or sorted by other columns than the timestamp */
+    bool _mapped;
+    QVector<qint64> _rows;
+    /** Number of mapped rows handed to the view */
+    int _fetched;
+
+    mutable QIcon _icons[3];
+  };
+}
+
+#endif
@@ -0,0 +1,136 @@
+/** @file
+  * @copyright Copyright (c) 2013 PROFACTOR GmbH. All rights reserved. 
+  *
+  * Redistribution and use in source and binary forms, with or without
+  * modification, are permitted provided that the following conditions are
+  * met:
+  *
+  *     * Redistributions of source code must retain the above copyright
+  * notice, this list of conditions and the following disclaimer.
+  *     * Redistributions in binary form must reproduce the above
+  * copyright notice, this list of conditions and the following disclaimer
+  * in the documentation and/or other materials provided with the
+  * distribution.
+  *     * Neither the name of Profactor GmbH nor the names of its
+  * contributors may be used to endorse or promote products derived from
+  * this software without specific prior written permission.
+  *
+  * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  *
+  * @authors christoph.kopf@profactor.at
+  *          florian.eckerstorfer@profactor.at
+  */
+
+#ifndef LOG_SINK_H
+#define LOG_SINK_H
+
+#pragma once
+
+#include "log_coalescer.h"
+
+#include <QThread>
+#include <QAtomicPointer>
+#include <QAtomicInt>
+#include <QElapsedTimer>
+#include <QString>
+#include <QByteArray>
+#include <QFile>
+
+#include <reconstructmesdk/types.h>
+
+namespace ReconstructMeGUI {
+
+  /** Streams log messages to disk on a background thread.
+   *
+   *  Producers on any thread hand messages over through a lock-free queue.
+   *  The sink thread appends each message as a length-delimited 
+   *  logging_info.log_entry record, tagged as field 1 of logging_info. A log 
+   *  file is therefore a valid serialized logging_info message at every 
+   *  record boundary. Every sink writes its own file, named after the tag, 
+   *  start time and process id, so concurrent instances and batch jobs never 
+   *  share a file. Files are rotated when they exceed a size limit, logs of 
+   *  older sessions are pruned on start.
+   */
+  class log_sink : public QThread
+  {
+  public:
+    log_sink(const QString &dir, const QString &tag = QString(), qint64 max_file_bytes = 8 * 1024 * 1024, int max_files = 5);
+    ~log_sink();
+
+    /** Log directory next to the application settings */
+    static QString default_dir();
+
+    /** Queues a message, safe to call from any thread */
+    void push(reme_log_severity_t sev, const QString &message);
+    /** Queues a coalesced record, safe to call from any thread */
+    void push(const log_record &r);
+    /** Writes all queued messages and stops the sink thread */
+    void stop();
+    /** Blocks until all messages queued so far are written */
+    void sync();
+
+    /** Path of the file currently written */
+    QString path() const;
+    /** Number of entries written since start */
+    int written() const;
+    /** Records with a time of at least msecs, read back from the current and 
+     *  rotated files of this sink, as a serialized logging_info message */
+    QByteArray records_since(qint64 msecs) const;
+
+    /** Monotonic time since the sink was created in microseconds */
+    qint64 now_us() const;
+    /** Converts a monotonic time to milliseconds since epoch */
+    qint64 to_msecs(qint64 us) const;
+
+  protected:
+    virtual void run();
+
+  private:
+    struct node {
+      node() : next(0) {}
+      QAtomicPointer<node> next;
+      reme_log_severity_t sev;
+      qint64 timestamp_us;
+      qint64 last_us;
+      int count;
+      QString message;
+    };
+
+    void enqueue(node *n);
+    node *dequeue();
+    /** Writes queued messages, returns false if there were none */
+    bool drain();
+    void rotate();
+    /** Removes the oldest session logs beyond the kept limit */
+    void prune();
+
+    // Queue, producers exchange the head, the sink thread owns the tail
+    QAtomicPointer<node> _head;
+    node *_tail;
+    node _stub;
+
+    QString _dir;
+    qint64 _max_file_bytes;
+    int _max_files;
+    QFile _file;
+    qint64 _file_bytes;
+    QAtomicInt _pushed;
+    QAtomicInt _written;
+    QAtomicInt _stop;
+
+    QElapsedTimer _clock;
+    qint64 _start_msecs;
+  };
+}
+
+#endif
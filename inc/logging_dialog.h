@@ -1,79 +1,97 @@
-/** @file
-  * @copyright Copyright (c) 2013 PROFACTOR GmbH. All rights reserved. 
-  *
-  * Redistribution and use in source and binary forms, with or without
-  * modification, are permitted provided that the following conditions are
-  * met:
-  *
-  *     * Redistributions of source code must retain the above copyright
-  * notice, this list of conditions and the following disclaimer.
-  *     * Redistributions in binary form must reproduce the above
-  * copyright notice, this list of conditions and the following disclaimer
-  * in the documentation and/or other materials provided with the
-  * distribution.
-  *     * Neither the name of Profactor GmbH nor the names of its
-  * contributors may be used to endorse or promote products derived from
-  * this software without specific prior written permission.
-  *
-  * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
-  * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
-  * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
-  * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
-  * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
-  * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
-  * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
-  * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
-  * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
-  * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
-  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
-  *
-  * @authors christoph.kopf@profactor.at
-  *          florian.eckerstorfer@profactor.at
-  */
-
-#ifndef LOGGING_WIDGET_H
-#define LOGGING_WIDGET_H
-
-#include "window_dialog.h"
-#include "reme_resource_manager.h"
-
-#include <QStandardItemModel>
-#include <QSortFilterProxyModel>
-
-#include <reconstructmesdk/types.h>
-
-// Forward declarations
-namespace Ui {
-  class logging_widget;
-}
-
-namespace ReconstructMeGUI {
-
-  /** This is dialog provides logging information */
-  class logging_dialog : public window_dialog
-  {
-    Q_OBJECT;
-
-  public:
-    logging_dialog(std::shared_ptr<reme_resource_manager> rm, QWidget *parent = 0, Qt::WindowFlags f = 0);
-    ~logging_dialog();
-
-  public slots:
-    /** This will append a log-string */
-    void add_log_message(reme_log_severity_t sev, const QString &log);
-
-  public slots:
-    void clear_log();
-
-    void save_log();
-
-  private:
-    Ui::logging_widget *_ui;
-    QStandardItemModel *_log_model;
-    QSortFilterProxyModel *_proxy_model;
-
-    std::shared_ptr<reme_resource_manager> _rm;
-  };
-} 
-
+/** @file
+  * @copyright Copyright (c) 2013 PROFACTOR GmbH. All rights reserved. 
+  *
+  * Redistribution and use in source and binary forms, with or without
+  * modification, are permitted provided that the following conditions are
+  * met:
+  *
+  *     * Redistributions of source code must retain the above copyright
+  * notice, this list of conditions and the following disclaimer.
+  *     * Redistributions in binary form must reproduce the above
+  * copyright notice, this list of conditions and the following disclaimer
+  * in the documentation and/or other materials provided with the
+  * distribution.
+  *     * Neither the name of Profactor GmbH nor the names of its
+  * contributors may be used to endorse or promote products derived from
+  * this software without specific prior written permission.
+  *
+  * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  *
+  * @authors christoph.kopf@profactor.at
+  *          florian.eckerstorfer@profactor.at
+  */
+
+#ifndef LOGGING_WIDGET_H
+#define LOGGING_WIDGET_H
+
+#include "window_dialog.h"
+#include "reme_resource_manager.h"
+
+#include <QTimer>
+
+
+#include <reconstructmesdk/types.h>
+
+// Forward declarations
+namespace Ui {
+  class logging_widget;
+}
+
+namespace ReconstructMeGUI {
+
+  class log_model;
+  class log_file_model;
+
+  /** This is dialog provides logging information */
+  class logging_dialog : public window_dialog
+  {
+    Q_OBJECT;
+
+  public:
+    logging_dialog(std::shared_ptr<reme_resource_manager> rm, QWidget *parent = 0, Qt::WindowFlags f = 0);
+    ~logging_dialog();
+
+  public slots:
+    /** This will append a log-string, it is shown with the next batch */
+    void add_log_message(reme_log_severity_t sev, const QString &log);
+    /** Appends count identical messages as one entry */
+    void add_repeated_log_message(reme_log_severity_t sev, const QString &log, int count, qint64 first_msecs, qint64 last_msecs);
+
+  public slots:
+    void clear_log();
+
+    void save_log();
+
+    /** Shows a saved or streamed log file instead of the live log */
+    void open_log();
+    void show_live_log();
+
+  private slots:
+    void log_flushed();
+    /** Restarts the delay before the filter is applied */
+    void filter_changed();
+    void apply_filter();
+    void log_file_indexed(int num_records);
+
+  private:
+    Ui::logging_widget *_ui;
+    log_model *_log_model;
+    log_file_model *_file_model;
+    bool _columns_sized;
+    QTimer *_filter_timer;
+
+    std::shared_ptr<reme_resource_manager> _rm;
+  };
+} 
+
 #endif // LOGGING_WIDGET_H
\ No newline at end of file
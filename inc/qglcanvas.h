@@ -1,65 +1,68 @@
-/** @file
-  * @copyright Copyright (c) 2013 PROFACTOR GmbH. All rights reserved. 
-  *
-  * Redistribution and use in source and binary forms, with or without
-  * modification, are permitted provided that the following conditions are
-  * met:
-  *
-  *     * Redistributions of source code must retain the above copyright
-  * notice, this list of conditions and the following disclaimer.
-  *     * Redistributions in binary form must reproduce the above
-  * copyright notice, this list of conditions and the following disclaimer
-  * in the documentation and/or other materials provided with the
-  * distribution.
-  *     * Neither the name of Profactor GmbH nor the names of its
-  * contributors may be used to endorse or promote products derived from
-  * this software without specific prior written permission.
-  *
-  * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
-  * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
-  * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
-  * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
-  * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
-  * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
-  * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
-  * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
-  * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
-  * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
-  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
-  *
-  * @authors christoph.kopf@profactor.at
-  *          florian.eckerstorfer@profactor.at
-  */
-  
-#pragma once
-
-#include <QtOpenGL/QGLWidget>
-#include <QImage>
-#include <QColor>
-
-namespace ReconstructMeGUI {
-
-  /** Provides a fast drawing widget, for an QImage */
-  class QGLCanvas : public QGLWidget
-  {
-    Q_OBJECT;
-
-    public:
-      QGLCanvas(QWidget* parent = NULL);
-      
-    public slots:
-      void set_image(int width, int height, const void *data, int length);
-      void fill(const QColor &color = QColor(100, 100, 100));
-
-    protected:
-      /** Render the content of the image */
-      virtual void paintEvent(QPaintEvent *event);
-
-    private:
-      std::shared_ptr<QImage> _img;
-      int _width;
-      int _height;
-  };
-
-}
-
+/** @file
+  * @copyright Copyright (c) 2013 PROFACTOR GmbH. All rights reserved. 
+  *
+  * Redistribution and use in source and binary forms, with or without
+  * modification, are permitted provided that the following conditions are
+  * met:
+  *
+  *     * Redistributions of source code must retain the above copyright
+  * notice, this list of conditions and the following disclaimer.
+  *     * Redistributions in binary form must reproduce the above
+  * copyright notice, this list of conditions and the following disclaimer
+  * in the documentation and/or other materials provided with the
+  * distribution.
+  *     * Neither the name of Profactor GmbH nor the names of its
+  * contributors may be used to endorse or promote products derived from
+  * this software without specific prior written permission.
+  *
+  * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  *
+  * @authors christoph.kopf@profactor.at
+  *          florian.eckerstorfer@profactor.at
+  */
+  
+#pragma once
+
+#include <QtOpenGL/QGLWidget>
+#include <QImage>
+#include <QColor>
+
+namespace ReconstructMeGUI {
+
+  /** Provides a fast drawing widget, for an QImage */
+  class QGLCanvas : public QGLWidget
+  {
+    Q_OBJECT;
+
+    public:
+      QGLCanvas(QWidget* parent = NULL);
+
+      /** Copy of the image currently shown */
+      QImage image() const;
+      
+    public slots:
+      void set_image(int width, int height, const void *data, int length);
+      void fill(const QColor &color = QColor(100, 100, 100));
+
+    protected:
+      /** Render the content of the image */
+      virtual void paintEvent(QPaintEvent *event);
+
+    private:
+      std::shared_ptr<QImage> _img;
+      int _width;
+      int _height;
+  };
+
+}
+
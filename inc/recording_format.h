@@ -0,0 +1,100 @@
+/** @file
+  * @copyright Copyright (c) 2013 PROFACTOR GmbH. All rights reserved. 
+  *
+  * Redistribution and use in source and binary forms, with or without
+  * modification, are permitted provided that the following conditions are
+  * met:
+  *
+  *     * Redistributions of source code must retain the above copyright
+  * notice, this list of conditions and the following disclaimer.
+  *     * Redistributions in binary form must reproduce the above
+  * copyright notice, this list of conditions and the following disclaimer
+  * in the documentation and/or other materials provided with the
+  * distribution.
+  *     * Neither the name of Profactor GmbH nor the names of its
+  * contributors may be used to endorse or promote products derived from
+  * this software without specific prior written permission.
+  *
+  * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  *
+  * @authors christoph.kopf@profactor.at
+  *          florian.eckerstorfer@profactor.at
+  */
+
+#ifndef RECORDING_FORMAT_H
+#define RECORDING_FORMAT_H
+
+#pragma once
+
+#include "recording.pb.h"
+
+#include <QByteArray>
+#include <QVector>
+
+namespace ReconstructMeGUI {
+
+  /** On-disk layout of frame recordings 
+   *
+   *  A recording starts with an eight byte magic followed by a sequence of 
+   *  chunks. Each chunk consists of a little-endian 32bit type, a little-endian
+   *  32bit payload size and the payload itself, which is a serialized message
+   *  of recording.proto. The first chunk is a recording_header, followed by 
+   *  any number of recorded_frame chunks. When a recording is closed properly
+   *  a recording_index chunk is appended and the file ends with a trailer
+   *  holding the 64bit offset of the index chunk and a second magic.
+   */
+  namespace recording {
+    const char magic[8] = { 'R', 'M', 'R', 'E', 'C', 0, 0, 1 };
+    const char trailer_magic[8] = { 'R', 'M', 'I', 'D', 'X', 0, 0, 1 };
+    const int magic_size = 8;
+    const int chunk_header_size = 8;
+    const int trailer_size = 16;
+    const int version = 1;
+
+    enum chunk_t { 
+      CHUNK_HEADER = 1, 
+      CHUNK_FRAME = 2, 
+      CHUNK_INDEX = 3 
+    };
+
+    /** Uncompressed image as grabbed from or fed to a sensor */
+    struct image {
+      int type;
+      int width, height, channels, num_bytes_per_channel, row_stride;
+      QByteArray data;
+    };
+
+    /** Uncompressed, synchronized set of images */
+    struct frame {
+      qint64 timestamp_us;
+      QVector<image> images;
+      QVector<float> pose;
+      bool track_success;
+    };
+
+    /** Encode raw image data into img. 
+     *
+     *  Images with two bytes per channel (depth) are row-wise delta coded and 
+     *  deflated, which is lossless. Three channel colour images are either 
+     *  deflated or, if lossy is set, JPEG compressed. */
+    void encode_image(
+      int type, const void *data, int length, 
+      int width, int height, int channels, int num_bytes_per_channel, int row_stride, 
+      bool lossy, recorded_image &img);
+
+    /** Decode the image payload of img to raw pixel data with the recorded row stride. */
+    bool decode_image(const recorded_image &img, QByteArray &data);
+  }
+}
+
+#endif // RECORDING_FORMAT_H
@@ -0,0 +1,182 @@
+/** @file
+  * @copyright Copyright (c) 2013 PROFACTOR GmbH. All rights reserved. 
+  *
+  * Redistribution and use in source and binary forms, with or without
+  * modification, are permitted provided that the following conditions are
+  * met:
+  *
+  *     * Redistributions of source code must retain the above copyright
+  * notice, this list of conditions and the following disclaimer.
+  *     * Redistributions in binary form must reproduce the above
+  * copyright notice, this list of conditions and the following disclaimer
+  * in the documentation and/or other materials provided with the
+  * distribution.
+  *     * Neither the name of Profactor GmbH nor the names of its
+  * contributors may be used to endorse or promote products derived from
+  * this software without specific prior written permission.
+  *
+  * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  *
+  * @authors christoph.kopf@profactor.at
+  *          florian.eckerstorfer@profactor.at
+  */
+
+#ifndef REME_HANDLES_H
+#define REME_HANDLES_H
+
+#pragma once
+
+#include <QMutex>
+#include <QVector>
+
+#include <reconstructmesdk/reme.h>
+
+namespace ReconstructMeGUI {
+
+  /** Scoped, move-only owner of an SDK object created on a context.
+   *
+   *  The object is destroyed with Destroy when the handle goes out of scope
+   *  or is reset. Objects still alive when their context is destroyed are
+   *  released by the SDK, so handles must not outlive their context.
+   */
+  template<typename T, reme_error_t (*Destroy)(reme_context_t, T*)>
+  class reme_handle {
+  public:
+    typedef T handle_type;
+
+    reme_handle() : _c(0), _h(), _valid(false) {}
+    reme_handle(reme_context_t c, T h) : _c(c), _h(h), _valid(true) {}
+    reme_handle(reme_handle &&other) : _c(other._c), _h(other._h), _valid(other._valid) {
+      other._valid = false;
+    }
+    ~reme_handle() { 
+      reset(); 
+    }
+
+    reme_handle &operator=(reme_handle &&other) {
+      if (this != &other) {
+        reset();
+        _c = other._c;
+        _h = other._h;
+        _valid = other._valid;
+        other._valid = false;
+      }
+      return *this;
+    }
+
+    /** Replaces the owned object by one created with create, e.g. reme_image_create */
+    bool create(reme_context_t c, reme_error_t (*create)(reme_context_t, T*)) {
+      reset();
+      T h;
+      if (!REME_SUCCESS(create(c, &h)))
+        return false;
+      _c = c;
+      _h = h;
+      _valid = true;
+      return true;
+    }
+
+    /** Destroys the owned object */
+    void reset() {
+      if (_valid)
+        Destroy(_c, &_h);
+      _valid = false;
+    }
+
+    /** Gives up ownership without destroying the object */
+    T release() {
+      _valid = false;
+      return _h;
+    }
+
+    T get() const { return _h; }
+    bool valid() const { return _valid; }
+
+  private:
+    reme_handle(const reme_handle &);
+    reme_handle &operator=(const reme_handle &);
+
+    reme_context_t _c;
+    T _h;
+    bool _valid;
+  };
+
+  typedef reme_handle<reme_options_t, &reme_options_destroy> scoped_options;
+  typedef reme_handle<reme_image_t, &reme_image_destroy> scoped_image;
+  typedef reme_handle<reme_license_t, &reme_license_destroy> scoped_license;
+  typedef reme_handle<reme_calibrator_t, &reme_calibrator_destroy> scoped_calibrator;
+  typedef reme_handle<reme_sensor_t, &reme_sensor_destroy> scoped_sensor;
+  typedef reme_handle<reme_volume_t, &reme_volume_destroy> scoped_volume;
+  typedef reme_handle<reme_surface_t, &reme_surface_destroy> scoped_surface;
+
+  /** Recycles options bindings of a single context.
+   *
+   *  Options objects are bound and rebound on almost every SDK call. Leases
+   *  hand them back to the pool instead of destroying them, so the steady 
+   *  state creates no new objects. Thread-safe.
+   */
+  class options_pool {
+  public:
+    /** Move-only loan of an options object, returned to the pool on destruction */
+    class lease {
+    public:
+      lease() : _pool(0), _generation(0), _o(), _valid(false) {}
+      lease(lease &&other);
+      ~lease();
+
+      lease &operator=(lease &&other);
+
+      reme_options_t get() const { return _o; }
+      bool valid() const { return _valid; }
+
+    private:
+      friend class options_pool;
+      lease(options_pool *pool, int generation, reme_options_t o);
+      lease(const lease &);
+      lease &operator=(const lease &);
+
+      void give_back();
+
+      options_pool *_pool;
+      int _generation;
+      reme_options_t _o;
+      bool _valid;
+    };
+
+    options_pool();
+    ~options_pool();
+
+    /** Destroys pooled objects of the previous context and switches to c. Pass 0 before destroying the context. 
+     *  Outstanding leases of earlier generations are dropped when they are returned, even if c reuses the 
+     *  handle value of the previous context. */
+    void reset(reme_context_t c);
+
+    /** Reuses an idle options object or creates a new one. Check lease::valid. */
+    lease acquire();
+
+    /** Number of options objects created since the last reset */
+    int num_created() const;
+
+  private:
+    void give_back(int generation, reme_options_t o);
+
+    mutable QMutex _m;
+    reme_context_t _c;
+    /** Bumped on every reset, identifies the context leases were taken from */
+    int _generation;
+    QVector<reme_options_t> _idle;
+    int _num_created;
+  };
+}
+
+#endif
@@ -1,140 +1,302 @@
-/** @file
-  * @copyright Copyright (c) 2013 PROFACTOR GmbH. All rights reserved. 
-  *
-  * Redistribution and use in source and binary forms, with or without
-  * modification, are permitted provided that the following conditions are
-  * met:
-  *
-  *     * Redistributions of source code must retain the above copyright
-  * notice, this list of conditions and the following disclaimer.
-  *     * Redistributions in binary form must reproduce the above
-  * copyright notice, this list of conditions and the following disclaimer
-  * in the documentation and/or other materials provided with the
-  * distribution.
-  *     * Neither the name of Profactor GmbH nor the names of its
-  * contributors may be used to endorse or promote products derived from
-  * this software without specific prior written permission.
-  *
-  * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
-  * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
-  * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
-  * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
-  * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
-  * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
-  * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
-  * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
-  * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
-  * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
-  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
-  *
-  * @authors christoph.kopf@profactor.at
-  *          florian.eckerstorfer@profactor.at
-  */
-  
-#ifndef REME_RESOURCE_MANAGER_H
-#define REME_RESOURCE_MANAGER_H
-
-#pragma once
-
-#include "types.h"
-#include "frame_grabber.h"
-
-#include "opencl_info.pb.h"
-#include "surface.pb.h"
-#include "hardware.pb.h"
-
-#include <ctime>
-
-#include <QObject>
-#include <QPair>
-#include <QFuture>
-#include <QFutureWatcher>
-#include <QSharedPointer>
-
-#include <reconstructmesdk/types.h>
-
-// FoWrward declarations
-class QImage;
-
-namespace ReconstructMeGUI {
-
-  /** This class provides scanning utilities */
-  class reme_resource_manager : public QObject 
-  {  
-    Q_OBJECT;
-    
-  public:
-    reme_resource_manager();
-    ~reme_resource_manager();
-
-  public slots:
-    void initialize();
-
-    const reme_context_t context() const;
-    const reme_sensor_t sensor() const;
-    const reme_volume_t volume() const;
-    
-    void get_version(std::string& version);
-    void get_hardware_hashes(hardware& hashes);
-    void get_opencl_info(opencl_info &ocl);
-    void new_log_message(reme_log_severity_t sev, const QString &log);
-
-    bool has_valid_license() const;
-
-    reme_calibrator_t new_calibrator() const;
-    void destroy_calibrator(reme_calibrator_t calib);
-
-    reme_image_t new_image() const;
-    void destroy_image(reme_image_t image);
-
-    void set_frame_grabber(std::shared_ptr<frame_grabber> fg);
-    void start_scanning();
-    void stop_scanning();
-    void scan();
-    void reset_volume();
-     
-    void generate_surface(float face_decimation);
-
-    void save(const QString &filename);
-
-  signals:
-    void surface(bool has_surface,
-      const float *points, int num_points,
-      const float *normals, int num_normals,
-      const unsigned *faces, int num_faces);
-
-    void initializing(init_t what);
-    void initialized(init_t what, bool success);
-    void sdk_initialized(bool success);
-    void initializing_sdk();
-    void log_message(reme_log_severity_t sev, const QString &log);
-
-    void current_fps(const float);
-   
-  private:
-    bool try_open_sensor(const char *driver);
-    
-    bool open_sensor();
-    bool compile_context();
-    bool apply_license();
-
-    reme_context_t _c;
-    reme_sensor_t _s;
-    reme_volume_t _v;
-    reme_surface_t _p;
-
-    bool _has_compiled_context;
-    bool _has_sensor;
-    bool _has_volume;
-    bool _has_valid_license;
-
-    std::shared_ptr<frame_grabber> _fg;
-
-    bool _lost_track_prev;
-
-    clock_t _c0;
-    int _cnt;
-  };
-}
-
+/** @file
+  * @copyright Copyright (c) 2013 PROFACTOR GmbH. All rights reserved. 
+  *
+  * Redistribution and use in source and binary forms, with or without
+  * modification, are permitted provided that the following conditions are
+  * met:
+  *
+  *     * Redistributions of source code must retain the above copyright
+  * notice, this list of conditions and the following disclaimer.
+  *     * Redistributions in binary form must reproduce the above
+  * copyright notice, this list of conditions and the following disclaimer
+  * in the documentation and/or other materials provided with the
+  * distribution.
+  *     * Neither the name of Profactor GmbH nor the names of its
+  * contributors may be used to endorse or promote products derived from
+  * this software without specific prior written permission.
+  *
+  * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  *
+  * @authors christoph.kopf@profactor.at
+  *          florian.eckerstorfer@profactor.at
+  */
+  
+#ifndef REME_RESOURCE_MANAGER_H
+#define REME_RESOURCE_MANAGER_H
+
+#pragma once
+
+#include "types.h"
+#include "settings.h"
+#include "frame_grabber.h"
+#include "frame_player.h"
+#include "kernel_cache.h"
+#include "device_profile.h"
+#include "config_tuner.h"
+#include "session_file.h"
+#include "trajectory.h"
+#include "log_sink.h"
+#include "log_coalescer.h"
+#include "reme_handles.h"
+#include "settings_store.h"
+#include "config_options.h"
+
+#include "opencl_info.pb.h"
+#include "surface.pb.h"
+#include "hardware.pb.h"
+
+#include <ctime>
+
+#include <QObject>
+#include <QPair>
+#include <QFuture>
+#include <QFutureWatcher>
+#include <QSharedPointer>
+#include <QHash>
+#include <QVariant>
+#include <QStringList>
+#include <QVector>
+#include <QElapsedTimer>
+#include <QList>
+#include <QMutex>
+#include <QSemaphore>
+#include <QAtomicInt>
+#include <QTimer>
+
+#include <reconstructmesdk/types.h>
+
+// FoWrward declarations
+class QImage;
+
+namespace ReconstructMeGUI {
+
+  /** This class provides scanning utilities */
+  class reme_resource_manager : public QObject 
+  {  
+    Q_OBJECT;
+    
+  public:
+    /** name tags the log file, batch jobs pass their job name */
+    explicit reme_resource_manager(const QString &name = QString());
+    ~reme_resource_manager();
+
+    /** Use value instead of the persistent setting tag. Takes effect on the next initialize. */
+    void override_setting(const QString &tag, const QVariant &value);
+
+  public slots:
+    void initialize();
+    /** Applies changes of the config file to the running context where possible */
+    void reload_config();
+    /** Measures every OpenCL device in the background, emits devices_profiled when done */
+    void profile_devices();
+    /** Captures a few seconds of depth from the current sensor and searches the highest volume resolution meeting target_fps */
+    void tune_config(double target_fps);
+
+    const reme_context_t context() const;
+    const reme_sensor_t sensor() const;
+    const reme_volume_t volume() const;
+    /** Source of replayed frames, or null if the sensor is live */
+    std::shared_ptr<frame_player> player() const;
+    
+    void get_version(std::string& version);
+    void get_hardware_hashes(hardware& hashes);
+    void get_opencl_info(opencl_info &ocl);
+    void new_log_message(reme_log_severity_t sev, const QString &log);
+
+    /** Measured frames per second of device_id of ocl for the compiled volume, negative if not profiled */
+    float device_fps(const opencl_info &ocl, int device_id) const;
+
+    bool has_valid_license() const;
+    /** File the log of this session is streamed to */
+    QString log_file() const;
+
+    reme_calibrator_t new_calibrator() const;
+    void destroy_calibrator(reme_calibrator_t calib);
+
+    reme_image_t new_image() const;
+    void destroy_image(reme_image_t image);
+
+    void set_frame_grabber(std::shared_ptr<frame_grabber> fg);
+    void start_scanning();
+    void stop_scanning();
+    void scan();
+    void reset_volume();
+     
+    void generate_surface(float face_decimation);
+
+    void save(const QString &filename);
+    /** Writes mesh, poses, log, thumbnail and the settings of this scan into a session file */
+    void save_session(const QString &filename, const QByteArray &thumbnail_png);
+    /** Writes the camera trajectory of this scan, the format is chosen by the file suffix */
+    void export_trajectory(const QString &filename);
+
+  signals:
+    void surface(bool has_surface,
+      const float *points, int num_points,
+      const float *normals, int num_normals,
+      const unsigned *faces, int num_faces);
+
+    void initializing(init_t what);
+    void initialized(init_t what, bool success);
+    /** Emitted after each initialization step, executed is false if the step was skipped as unchanged */
+    void initialization_step(init_t what, bool executed, int msecs);
+    void sdk_initialized(bool success);
+    /** Emitted once per initialize with the time from its start to the first grabbed frame */
+    void first_frame(int msecs);
+    void initializing_sdk();
+    void log_message(reme_log_severity_t sev, const QString &log);
+    /** Emitted instead of log_message for count identical messages collapsed into one */
+    void log_repeated(reme_log_severity_t sev, const QString &log, int count, qint64 first_msecs, qint64 last_msecs);
+
+    /** Emitted by reload_config if the changed options require a new context */
+    void config_restart_required(const QStringList &options);
+
+    void current_fps(const float);
+    void devices_profiled();
+    /** Result of tune_config, resolution is zero if no candidate met the target */
+    void config_tuned(int x, int y, int z, float fps);
+   
+  private slots:
+    void frame_arrived();
+    /** Starts the tuning run of tune_config on the captured raw depth frames */
+    void tuning_frames_captured(const QVector<QByteArray> &frames, int width, int height);
+    /** Passes on repeats and suppressed messages held back by the coalescer */
+    void flush_log();
+
+  private:
+    /** Inputs of initialize, used to decide which resources need to be rebuilt */
+    struct configuration {
+      configuration() : device(opencl_device_default_tag), realtime(replay_realtime_default_tag) {}
+
+      QString license, license_stamp;
+      QString config, config_stamp;
+      int device;
+      QString sensor, sensor_stamp;
+      bool realtime;
+    };
+
+    QVariant setting(const char *tag, const QVariant &default_value) const;
+    configuration requested_configuration() const;
+    static QString file_stamp(const QString &path);
+    /** Starts a new trajectory file for the current scan */
+    void open_trajectory();
+
+    /** Node of the initialization dependency graph */
+    struct init_step {
+      init_step() : started(false), done(false), success(false), msecs(0), finished(0), completion(0) {}
+      init_step(init_t w, bool status, bool exec, bool (reme_resource_manager::*f)(), bool state) :
+        what(w), report_status(status), execute(exec), fn(f), current_state(state), 
+        started(false), done(false), success(false), msecs(0), finished(0), completion(0) {}
+
+      init_t what;
+      bool report_status;     ///< Emit status signals for this step
+      bool execute;           ///< False if the step is unchanged and skipped
+      bool (reme_resource_manager::*fn)();
+      bool current_state;     ///< Result reported for skipped steps
+      QList<int> deps;        ///< Indices of steps that must complete first
+
+      bool started, done, success;
+      int msecs;
+      QFuture<void> future;
+      QAtomicInt finished;    ///< Set by the worker before it releases completion
+      QSemaphore *completion; ///< Released once per finished step
+    };
+
+    /** Runs independent steps concurrently on the global thread pool, in completion order */
+    void run_steps(QVector<init_step> &steps, QStringList &report);
+    void execute_step(init_step *s);
+
+    bool try_open_sensor(const char *driver);
+    
+    bool open_sensor();
+    bool prepare_sensor();
+    bool open_replay_sensor();
+    bool compile_context();
+    /** Runs the device workloads on the global thread pool */
+    void run_profile(opencl_info ocl, QString config_path);
+    void run_tuning(config_tuner tuner, float target_fps);
+    bool apply_license();
+    /** Creates the surface and binds its generation and decimation options */
+    bool prepare_surface();
+    /** Writes coalesced records to the sink and emits them */
+    void publish_log(const QVector<log_record> &records);
+
+    reme_context_t _c;
+    reme_sensor_t _s;
+    reme_volume_t _v;
+    reme_surface_t _p;
+
+    bool _has_compiled_context;
+    bool _has_sensor;
+    bool _has_volume;
+    bool _has_valid_license;
+    bool _has_surface;
+    /** generate_surface produced faces since the last volume reset */
+    bool _has_mesh;
+
+    configuration _applied;
+    /** Content of the config file the context was compiled or last updated with */
+    config_options::values_t _applied_options;
+
+    QElapsedTimer _startup_timer;
+    bool _awaiting_first_frame;
+    /** Target of the pending tune_config run */
+    double _tune_target_fps;
+
+    kernel_cache _kernel_cache;
+    device_profile _device_profile;
+    /** Volume resolution of the compiled context, selects the matching profile */
+    QString _volume_resolution;
+    std::shared_ptr<log_sink> _log_sink;
+    log_coalescer _log_coalescer;
+    QMutex _log_mutex;
+    QTimer *_log_flush_timer;
+
+    options_pool _options;
+    scoped_license _license;
+
+    /** Derived from the volume geometry when the context is compiled */
+    float _merge_radius;
+    /** Options bound to the surface for its lifetime, reused by every extraction */
+    scoped_options _generation_binding;
+    scoped_options _decimation_binding;
+    decimation_options _decimation;
+    std::string _decimation_bytes;
+
+    std::shared_ptr<frame_grabber> _fg;
+    std::shared_ptr<frame_player> _player;
+    std::shared_ptr<frame_player> _prepared_player;
+
+    QHash<QString, QVariant> _overrides;
+    /** Settings as of the last initialize, read by the initialization steps */
+    settings_store::snapshot _settings;
+
+    bool _lost_track_prev;
+
+    /** Totals of the current scan, reset with the volume */
+    struct scan_stats {
+      scan_stats() : frames(0), tracked(0), msecs(0), start_msecs(0) {}
+      qint64 frames, tracked, msecs;
+      qint64 start_msecs;   ///< Wall clock start, bounds the log saved with a session
+    };
+    scan_stats _scan_stats;
+    QElapsedTimer _scan_timer;
+    /** Poses of the current scan, one file per scan */
+    std::shared_ptr<trajectory_writer> _trajectory;
+
+    clock_t _c0;
+    int _cnt;
+  };
+}
+
 #endif // REME_RESOURCE_MANAGER_H
\ No newline at end of file
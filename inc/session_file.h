@@ -0,0 +1,125 @@
+/** @file
+  * @copyright Copyright (c) 2013 PROFACTOR GmbH. All rights reserved. 
+  *
+  * Redistribution and use in source and binary forms, with or without
+  * modification, are permitted provided that the following conditions are
+  * met:
+  *
+  *     * Redistributions of source code must retain the above copyright
+  * notice, this list of conditions and the following disclaimer.
+  *     * Redistributions in binary form must reproduce the above
+  * copyright notice, this list of conditions and the following disclaimer
+  * in the documentation and/or other materials provided with the
+  * distribution.
+  *     * Neither the name of Profactor GmbH nor the names of its
+  * contributors may be used to endorse or promote products derived from
+  * this software without specific prior written permission.
+  *
+  * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  *
+  * @authors christoph.kopf@profactor.at
+  *          florian.eckerstorfer@profactor.at
+  */
+
+#ifndef SESSION_FILE_H
+#define SESSION_FILE_H
+
+#pragma once
+
+#include "session.pb.h"
+
+#include <QFile>
+#include <QString>
+#include <QByteArray>
+
+namespace ReconstructMeGUI {
+
+  /** Self-contained scan session files
+   *
+   *  Sessions use the chunk layout of recordings: an eight byte magic, a 
+   *  sequence of chunks with a little-endian 32bit type and size, an index 
+   *  chunk and a trailer holding the offset of the index and a second magic.
+   *  The first chunk is a session_manifest, each further chunk holds the 
+   *  payload of one section. The index lists every section with its offset, 
+   *  compression and checksum, so single sections can be read or mapped 
+   *  without touching the rest of the file.
+   */
+  namespace session {
+    const char magic[8] = { 'R', 'M', 'S', 'E', 'S', 0, 0, 1 };
+    const char trailer_magic[8] = { 'R', 'M', 'S', 'I', 'X', 0, 0, 1 };
+    const int magic_size = 8;
+    const int chunk_header_size = 8;
+    const int trailer_size = 16;
+    const int version = 1;
+
+    enum chunk_t {
+      CHUNK_MANIFEST = 1,
+      CHUNK_SECTION = 2,
+      CHUNK_INDEX = 3
+    };
+
+    /** CRC-32 (IEEE) of data */
+    quint32 crc32(const uchar *data, qint64 length);
+  }
+
+  /** Writes a session file section by section */
+  class session_writer {
+  public:
+    session_writer();
+    ~session_writer();
+
+    bool open(const QString &file_name, const session_manifest &manifest);
+    /** Appends a section. Compression is skipped if it does not pay off. */
+    bool add_section(session_section::section_type type, const QString &name, const QByteArray &data, bool compress);
+    /** Writes index and trailer */
+    bool close();
+
+  private:
+    bool write_chunk(session::chunk_t type, const char *data, qint64 size);
+
+    QFile _file;
+    session_index _index;
+  };
+
+  /** Reads sections of a session file from a memory map */
+  class session_reader {
+  public:
+    session_reader();
+    ~session_reader();
+
+    bool open(const QString &file_name);
+    void close();
+
+    const session_manifest &manifest() const;
+    const session_index &index() const;
+    /** Index of the first section of the given type, -1 if there is none */
+    int find(session_section::section_type type) const;
+
+    /** Verifies and decompresses section i */
+    bool read(int i, QByteArray &data) const;
+    /** Mapped payload of an uncompressed section i, zero if it is compressed or damaged */
+    const uchar *map(int i, qint64 &size) const;
+
+  private:
+    bool read_chunk(qint64 offset, quint32 &type, const uchar *&payload, quint32 &size) const;
+
+    QFile _file;
+    const uchar *_map;
+    qint64 _map_size;
+
+    session_manifest _manifest;
+    session_index _index;
+  };
+}
+
+#endif
@@ -1,52 +1,60 @@
-/** @file
-  * @copyright Copyright (c) 2013 PROFACTOR GmbH. All rights reserved. 
-  *
-  * Redistribution and use in source and binary forms, with or without
-  * modification, are permitted provided that the following conditions are
-  * met:
-  *
-  *     * Redistributions of source code must retain the above copyright
-  * notice, this list of conditions and the following disclaimer.
-  *     * Redistributions in binary form must reproduce the above
-  * copyright notice, this list of conditions and the following disclaimer
-  * in the documentation and/or other materials provided with the
-  * distribution.
-  *     * Neither the name of Profactor GmbH nor the names of its
-  * contributors may be used to endorse or promote products derived from
-  * this software without specific prior written permission.
-  *
-  * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
-  * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
-  * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
-  * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
-  * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
-  * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
-  * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
-  * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
-  * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
-  * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
-  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
-  *
-  * @authors christoph.kopf@profactor.at
-  *          florian.eckerstorfer@profactor.at
-  */
-  
-#pragma once
-
-namespace ReconstructMeGUI {
-  const char* const profactor_tag = "Profactor";
-  const char* const reme_tag = "ReconstructMe-1.2";
-  const char* const reme_tag_prev = "ReconstructMe-1.1";
-  const char* const save_path_tag = "save_path";
-  const char* const save_path_default_tag = "";
-  const char* const sensor_path_tag = "sensor_path";
-  const char* const sensor_path_default_tag = "openni;mskinect;file";
-  const char* const config_path_tag = "config_path";
-  const char* const config_path_default_tag = "";
-  const char* const license_file_tag = "license_file";
-  const char* const license_file_default_tag = "";
-  const char* const opencl_device_tag = "opencl_device";
-  const int opencl_device_default_tag = -1;
-
-  const char* const style_sheet_file_tag = ":/styles/darkorange.qss";
+/** @file
+  * @copyright Copyright (c) 2013 PROFACTOR GmbH. All rights reserved. 
+  *
+  * Redistribution and use in source and binary forms, with or without
+  * modification, are permitted provided that the following conditions are
+  * met:
+  *
+  *     * Redistributions of source code must retain the above copyright
+  * notice, this list of conditions and the following disclaimer.
+  *     * Redistributions in binary form must reproduce the above
+  * copyright notice, this list of conditions and the following disclaimer
+  * in the documentation and/or other materials provided with the
+  * distribution.
+  *     * Neither the name of Profactor GmbH nor the names of its
+  * contributors may be used to endorse or promote products derived from
+  * this software without specific prior written permission.
+  *
+  * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  *
+  * @authors christoph.kopf@profactor.at
+  *          florian.eckerstorfer@profactor.at
+  */
+  
+#pragma once
+
+namespace ReconstructMeGUI {
+  const char* const profactor_tag = "Profactor";
+  const char* const reme_tag = "ReconstructMe-1.2";
+  const char* const reme_tag_prev = "ReconstructMe-1.1";
+  const char* const save_path_tag = "save_path";
+  const char* const save_path_default_tag = "";
+  const char* const sensor_path_tag = "sensor_path";
+  const char* const sensor_path_default_tag = "openni;mskinect;file";
+  const char* const config_path_tag = "config_path";
+  const char* const config_path_default_tag = "";
+  const char* const license_file_tag = "license_file";
+  const char* const license_file_default_tag = "";
+  const char* const opencl_device_tag = "opencl_device";
+  const int opencl_device_default_tag = -1;
+  const char* const record_aux_lossy_tag = "record_aux_lossy";
+  const bool record_aux_lossy_default_tag = false;
+  const char* const replay_realtime_tag = "replay_realtime";
+  const bool replay_realtime_default_tag = true;
+  const char* const recording_suffix_tag = ".rmrec";
+  const char* const session_suffix_tag = ".rmsession";
+  const char* const trajectory_tum_suffix_tag = ".tum";
+  const char* const trajectory_kitti_suffix_tag = ".kitti";
+
+  const char* const style_sheet_file_tag = ":/styles/darkorange.qss";
 }
\ No newline at end of file
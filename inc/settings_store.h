@@ -0,0 +1,134 @@
+/** @file
+  * @copyright Copyright (c) 2013 PROFACTOR GmbH. All rights reserved. 
+  *
+  * Redistribution and use in source and binary forms, with or without
+  * modification, are permitted provided that the following conditions are
+  * met:
+  *
+  *     * Redistributions of source code must retain the above copyright
+  * notice, this list of conditions and the following disclaimer.
+  *     * Redistributions in binary form must reproduce the above
+  * copyright notice, this list of conditions and the following disclaimer
+  * in the documentation and/or other materials provided with the
+  * distribution.
+  *     * Neither the name of Profactor GmbH nor the names of its
+  * contributors may be used to endorse or promote products derived from
+  * this software without specific prior written permission.
+  *
+  * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  *
+  * @authors christoph.kopf@profactor.at
+  *          florian.eckerstorfer@profactor.at
+  */
+
+#ifndef SETTINGS_STORE_H
+#define SETTINGS_STORE_H
+
+#pragma once
+
+#include <QObject>
+#include <QHash>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QVariant>
+#include <QReadWriteLock>
+#include <QFuture>
+#include <QTimer>
+
+namespace ReconstructMeGUI {
+
+  /** Application settings held in memory.
+   *
+   *  The settings file is read once when the store is first used. Reads 
+   *  are served from memory, writes update memory immediately and are 
+   *  persisted in batches on a background thread shortly after. Threads 
+   *  that need a consistent view of the settings take a snapshot, which is 
+   *  an implicitly shared copy and does not block writers.
+   */
+  class settings_store : public QObject
+  {
+    Q_OBJECT;
+
+  public:
+    typedef QHash<QString, QVariant> values_t;
+
+    /** Immutable view of all settings at one point in time */
+    class snapshot {
+    public:
+      snapshot() {}
+      explicit snapshot(const values_t &values) : _values(values) {}
+
+      QVariant value(const QString &tag, const QVariant &default_value = QVariant()) const {
+        values_t::const_iterator i = _values.find(tag);
+        return i == _values.end() ? default_value : i.value();
+      }
+
+      template<class T> 
+      T get(const QString &tag, const T &default_value) const {
+        return value(tag, qVariantFromValue(default_value)).template value<T>();
+      }
+
+      const values_t &values() const { return _values; }
+
+    private:
+      values_t _values;
+    };
+
+    /** Process wide store of the ReconstructMe settings */
+    static settings_store &instance();
+
+    /** Directory of the settings file */
+    QString directory() const;
+
+    snapshot current() const;
+    QVariant value(const QString &tag, const QVariant &default_value = QVariant()) const;
+
+    template<class T> 
+    T get(const QString &tag, const T &default_value) const {
+      return value(tag, qVariantFromValue(default_value)).template value<T>();
+    }
+
+    /** Sets a single value, see set(const values_t &) */
+    void set(const QString &tag, const QVariant &value);
+    /** Sets values and emits one change notification for all keys actually changed */
+    void set(const values_t &values);
+
+    /** Writes pending changes to disk and waits until they are written */
+    void flush();
+
+  signals:
+    /** Emitted with the keys whose values changed */
+    void changed(const QStringList &keys);
+
+  private slots:
+    void persist();
+
+  private:
+    settings_store();
+    ~settings_store();
+
+    static void write(QString file_name, values_t values);
+
+    QString _file_name;
+    values_t _values;
+    /** Keys changed since the last persist */
+    QSet<QString> _dirty;
+    mutable QReadWriteLock _lock;
+
+    QTimer *_persist_timer;
+    QFuture<void> _persisting;
+  };
+}
+
+#endif
@@ -0,0 +1,145 @@
+/** @file
+  * @copyright Copyright (c) 2013 PROFACTOR GmbH. All rights reserved. 
+  *
+  * Redistribution and use in source and binary forms, with or without
+  * modification, are permitted provided that the following conditions are
+  * met:
+  *
+  *     * Redistributions of source code must retain the above copyright
+  * notice, this list of conditions and the following disclaimer.
+  *     * Redistributions in binary form must reproduce the above
+  * copyright notice, this list of conditions and the following disclaimer
+  * in the documentation and/or other materials provided with the
+  * distribution.
+  *     * Neither the name of Profactor GmbH nor the names of its
+  * contributors may be used to endorse or promote products derived from
+  * this software without specific prior written permission.
+  *
+  * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  *
+  * @authors christoph.kopf@profactor.at
+  *          florian.eckerstorfer@profactor.at
+  */
+
+#ifndef TRAJECTORY_H
+#define TRAJECTORY_H
+
+#pragma once
+
+#include <QThread>
+#include <QAtomicInt>
+#include <QMutex>
+#include <QVector>
+#include <QString>
+#include <QByteArray>
+#include <QFile>
+#include <QElapsedTimer>
+
+namespace ReconstructMeGUI {
+
+  /** Sensor pose of a single scanned frame */
+  struct trajectory_sample {
+    qint64 timestamp_us;      ///< Microseconds since the trajectory was opened
+    float pose[16];           ///< 4x4 row-major sensor pose, millimeters
+    bool track_success;
+  };
+
+  /** Binary trajectory files and text exports
+   *
+   *  A trajectory file starts with an eight byte magic and the 64bit start 
+   *  time in milliseconds since epoch, followed by fixed size records: the
+   *  64bit timestamp, the upper 3x4 part of the pose as 32bit floats and 
+   *  32bit flags. All values are little-endian. Fixed size records keep 
+   *  truncated files readable up to the last complete record.
+   */
+  namespace trajectory {
+    const char magic[8] = { 'R', 'M', 'T', 'R', 'J', 0, 0, 1 };
+    const int header_size = 16;
+    const int record_size = 8 + 12 * 4 + 4;
+
+    enum flags_t { 
+      FLAG_TRACK_SUCCESS = 1 
+    };
+
+    /** File header and records of samples */
+    QByteArray encode_header(qint64 start_msecs);
+    void encode(const trajectory_sample &s, char *record);
+    bool decode(const QByteArray &data, QVector<trajectory_sample> &samples, qint64 &start_msecs);
+    bool read(const QString &path, QVector<trajectory_sample> &samples, qint64 &start_msecs);
+
+    /** TUM RGB-D format: timestamp tx ty tz qx qy qz qw, seconds and meters */
+    bool export_tum(const QVector<trajectory_sample> &samples, qint64 start_msecs, const QString &path, bool tracked_only);
+    /** KITTI odometry format: row-major 3x4 pose per line, meters */
+    bool export_kitti(const QVector<trajectory_sample> &samples, const QString &path, bool tracked_only);
+  }
+
+  /** Collects the poses of the scan loop and streams them to disk.
+   *
+   *  The scan loop pushes samples into a single-producer single-consumer 
+   *  ring buffer without locking or allocating. A background thread moves 
+   *  them to the in-memory trajectory and appends them to the trajectory 
+   *  file. Samples are dropped and counted if the writer falls behind by 
+   *  more than the ring capacity.
+   */
+  class trajectory_writer : public QThread
+  {
+  public:
+    trajectory_writer();
+    ~trajectory_writer();
+
+    /** New trajectory file below the application settings, unique per call. 
+     *  Prunes older files to a fixed number. */
+    static QString default_path();
+
+    /** Truncates path and starts a new trajectory */
+    bool open(const QString &path);
+    /** Writes pending samples and stops the writer thread */
+    void close();
+    bool is_open() const;
+
+    /** Queues a sample. Wait-free, must always be called from the same thread. */
+    bool push(const trajectory_sample &s);
+    /** Blocks until all pushed samples are written, call from the pushing thread */
+    void sync();
+
+    /** Samples written since open */
+    QVector<trajectory_sample> samples() const;
+    int num_dropped() const;
+    qint64 start_msecs() const;
+    /** Monotonic time since open in microseconds */
+    qint64 now_us() const;
+
+  protected:
+    virtual void run();
+
+  private:
+    /** Moves queued samples to file and memory, returns false if there were none */
+    bool drain();
+
+    // Ring, the producer owns _head and the writer thread owns _tail
+    QVector<trajectory_sample> _ring;
+    QAtomicInt _head;
+    QAtomicInt _tail;
+    QAtomicInt _dropped;
+    QAtomicInt _stop;
+
+    QFile _file;
+    qint64 _start_msecs;
+    QElapsedTimer _clock;
+
+    mutable QMutex _mutex;
+    QVector<trajectory_sample> _samples;
+  };
+}
+
+#endif
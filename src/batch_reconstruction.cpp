@@ -0,0 +1,314 @@
+/** @file
+  * @copyright Copyright (c) 2013 PROFACTOR GmbH. All rights reserved. 
+  *
+  * Redistribution and use in source and binary forms, with or without
+  * modification, are permitted provided that the following conditions are
+  * met:
+  *
+  *     * Redistributions of source code must retain the above copyright
+  * notice, this list of conditions and the following disclaimer.
+  *     * Redistributions in binary form must reproduce the above
+  * copyright notice, this list of conditions and the following disclaimer
+  * in the documentation and/or other materials provided with the
+  * distribution.
+  *     * Neither the name of Profactor GmbH nor the names of its
+  * contributors may be used to endorse or promote products derived from
+  * this software without specific prior written permission.
+  *
+  * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  *
+  * @authors christoph.kopf@profactor.at
+  *          florian.eckerstorfer@profactor.at
+  */
+
+#include "batch_reconstruction.h"
+#include "reme_resource_manager.h"
+#include "frame_grabber.h"
+#include "settings.h"
+#include "defines.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QTextStream>
+#include <QDateTime>
+
+#include <reconstructmesdk/reme.h>
+
+#include <iostream>
+
+namespace ReconstructMeGUI {
+
+  QString json_escape(const QString &s) {
+    QString r;
+    for (int i = 0; i < s.size(); ++i) {
+      const QChar c = s.at(i);
+      if (c == '"' || c == '\\') 
+        r += '\\';
+      if (c == '\n') 
+        r += "\\n";
+      else if (c < QChar(0x20)) 
+        r += ' ';
+      else 
+        r += c;
+    }
+    return r;
+  }
+
+  batch_options::batch_options() :
+    sensor_path(sensor_path_default_tag),
+    config_path(config_path_default_tag),
+    license_path(license_file_default_tag),
+    device_id(opencl_device_default_tag),
+    decimation(1.f),
+    max_frames(0),
+    realtime(false)
+  {
+  }
+
+  bool batch_options::requested(const QStringList &args) {
+    return args.contains("--batch");
+  }
+
+  const char *batch_options::usage() {
+    return 
+      "Usage: ReconstructMeQt --batch --output <mesh> [options]\n"
+      "  --sensor <file>       sensor configuration or recording (.rmrec)\n"
+      "  --config <file>       reconstruction configuration\n"
+      "  --license <file>      license file\n"
+      "  --device <id>         OpenCL device id, -1 selects automatically\n"
+      "  --decimation <f>      fraction of faces to keep (0,1]\n"
+      "  --frames <n>          stop after n frames\n"
+      "  --realtime            replay recordings at recorded speed\n"
+      "  --report <file>       write JSON statistics\n"
+      "\n"
+      "       ReconstructMeQt --batch-manifest <file>\n"
+      "  runs the jobs of an INI job manifest concurrently\n";
+  }
+
+  bool batch_options::parse(const QStringList &args, batch_options &o, QString &error) {
+    for (int i = 1; i < args.size(); ++i) {
+      const QString &a = args[i];
+      const bool has_value = i + 1 < args.size();
+      bool ok = true;
+
+      if (a == "--batch") 
+        continue;
+      else if (a == "--realtime")
+        o.realtime = true;
+      else if (!has_value) {
+        error = "Missing value for " + a;
+        return false;
+      }
+      else if (a == "--sensor") 
+        o.sensor_path = args[++i];
+      else if (a == "--config") 
+        o.config_path = args[++i];
+      else if (a == "--license") 
+        o.license_path = args[++i];
+      else if (a == "--output") 
+        o.output_path = args[++i];
+      else if (a == "--report") 
+        o.report_path = args[++i];
+      else if (a == "--device") 
+        o.device_id = args[++i].toInt(&ok);
+      else if (a == "--decimation") 
+        o.decimation = args[++i].toFloat(&ok);
+      else if (a == "--frames") 
+        o.max_frames = args[++i].toInt(&ok);
+      else {
+        error = "Unknown argument " + a;
+        return false;
+      }
+
+      if (!ok) {
+        error = "Invalid value for " + a;
+        return false;
+      }
+    }
+
+    if (o.output_path.isEmpty()) {
+      error = "No output file given";
+      return false;
+    }
+
+    if (o.decimation <= 0.f || o.decimation > 1.f) {
+      error = "Decimation must be in (0,1]";
+      return false;
+    }
+
+    return true;
+  }
+
+  batch_reconstruction::batch_reconstruction(const batch_options &o, QObject *parent) :
+    QObject(parent),
+    _o(o),
+    _init_ms(0), _scan_ms(0), _surface_ms(0), _save_ms(0),
+    _num_frames(0),
+    _num_points(0), _num_faces(0),
+    _initialized(false), _has_surface(false), _saved(false), _success(false)
+  {
+  }
+
+  batch_reconstruction::~batch_reconstruction() {
+  }
+
+  bool batch_reconstruction::succeeded() const {
+    return _success;
+  }
+
+  int batch_reconstruction::num_frames() const {
+    return _num_frames;
+  }
+
+  qint64 batch_reconstruction::scan_ms() const {
+    return _scan_ms;
+  }
+
+  void batch_reconstruction::run() {
+    _rm = std::shared_ptr<reme_resource_manager>(new reme_resource_manager(_o.name));
+    _rm->override_setting(sensor_path_tag, _o.sensor_path);
+    _rm->override_setting(config_path_tag, _o.config_path);
+    _rm->override_setting(license_file_tag, _o.license_path);
+    _rm->override_setting(opencl_device_tag, _o.device_id);
+    _rm->override_setting(replay_realtime_tag, _o.realtime);
+
+    // Connect before the frame grabber, so scanning is set up before grabbing starts
+    connect(_rm.get(), SIGNAL(sdk_initialized(bool)), SLOT(sdk_initialized(bool)));
+    connect(_rm.get(), SIGNAL(log_message(reme_log_severity_t, const QString &)), SLOT(log_message(reme_log_severity_t, const QString &)));
+    connect(_rm.get(), SIGNAL(surface(bool, const float *, int, const float *, int, const unsigned *, int)), SLOT(surface(bool, const float *, int, const float *, int, const unsigned *, int)));
+
+    _fg = std::shared_ptr<frame_grabber>(new frame_grabber(_rm));
+    _rm->set_frame_grabber(_fg);
+    connect(_fg.get(), SIGNAL(stopped_grabbing()), SLOT(grabbing_stopped()), Qt::QueuedConnection);
+
+    _clock.start();
+    _rm->initialize();
+  }
+
+  void batch_reconstruction::sdk_initialized(bool success) {
+    _init_ms = _clock.restart();
+    _initialized = success;
+
+    if (!success) {
+      finish(false, "Initialization failed");
+      return;
+    }
+
+    _rm->start_scanning();
+    connect(_fg.get(), SIGNAL(frames_updated()), SLOT(frame_processed()));
+  }
+
+  void batch_reconstruction::frame_processed() {
+    _num_frames++;
+    if (_o.max_frames > 0 && _num_frames >= _o.max_frames)
+      _fg->stop();
+  }
+
+  void batch_reconstruction::grabbing_stopped() {
+    if (!_initialized)
+      return;
+
+    _scan_ms = _clock.restart();
+    _rm->stop_scanning();
+
+    _rm->generate_surface(_o.decimation);
+    _surface_ms = _clock.restart();
+
+    if (!_has_surface) {
+      finish(false, "Could not generate surface");
+      return;
+    }
+
+    QFile::remove(_o.output_path);
+    _rm->save(_o.output_path);
+    _save_ms = _clock.restart();
+    _saved = QFileInfo(_o.output_path).exists();
+
+    if (_saved)
+      finish(true, "Saved " + _o.output_path);
+    else
+      finish(false, "Could not save " + _o.output_path);
+  }
+
+  void batch_reconstruction::surface(bool has_surface,
+      const float *points, int num_points,
+      const float *normals, int num_normals,
+      const unsigned *faces, int num_faces) 
+  {
+    _has_surface = has_surface;
+    _num_points = has_surface ? num_points : 0;
+    _num_faces = has_surface ? num_faces : 0;
+  }
+
+  void batch_reconstruction::log_message(reme_log_severity_t sev, const QString &log) {
+    if (sev == REME_LOG_SEVERITY_ERROR)
+      _errors.push_back(log);
+    std::cerr << prefix().toStdString() << log.toStdString() << std::endl;
+  }
+
+  QString batch_reconstruction::prefix() const {
+    return _o.name.isEmpty() ? QString() : "[" + _o.name + "] ";
+  }
+
+  void batch_reconstruction::finish(bool success, const QString &message) {
+    _success = success;
+    std::cerr << prefix().toStdString() << message.toStdString() << std::endl;
+
+    if (!_o.report_path.isEmpty() && !write_report(message))
+      std::cerr << prefix().toStdString() << "Could not write report " << _o.report_path.toStdString() << std::endl;
+
+    emit finished(success ? 0 : 1);
+  }
+
+  bool batch_reconstruction::write_report(const QString &message) const {
+    QFile f(_o.report_path);
+    if (!f.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text))
+      return false;
+
+    std::string version;
+    if (_rm)
+      _rm->get_version(version);
+
+    const double fps = _scan_ms > 0 ? 1000.0 * _num_frames / _scan_ms : 0.0;
+
+    QTextStream out(&f);
+    out << "{\n";
+    out << "  \"success\": " << (_success ? "true" : "false") << ",\n";
+    out << "  \"message\": \"" << json_escape(message) << "\",\n";
+    out << "  \"date\": \"" << QDateTime::currentDateTime().toString(Qt::ISODate) << "\",\n";
+    out << "  \"gui_version\": \"" << RECONSTRUCTMEQT_VERSION_MAJOR << "." << RECONSTRUCTMEQT_VERSION_MINOR << "." << RECONSTRUCTMEQT_VERSION_BUILD << "\",\n";
+    out << "  \"sdk_version\": \"" << json_escape(QString::fromStdString(version)) << "\",\n";
+    out << "  \"sensor\": \"" << json_escape(_o.sensor_path) << "\",\n";
+    out << "  \"config\": \"" << json_escape(_o.config_path) << "\",\n";
+    out << "  \"output\": \"" << json_escape(_o.output_path) << "\",\n";
+    out << "  \"device_id\": " << _o.device_id << ",\n";
+    out << "  \"decimation\": " << _o.decimation << ",\n";
+    out << "  \"frames\": " << _num_frames << ",\n";
+    out << "  \"fps\": " << fps << ",\n";
+    out << "  \"vertices\": " << _num_points << ",\n";
+    out << "  \"faces\": " << _num_faces << ",\n";
+    out << "  \"timing_ms\": {\n";
+    out << "    \"initialize\": " << _init_ms << ",\n";
+    out << "    \"scan\": " << _scan_ms << ",\n";
+    out << "    \"generate_surface\": " << _surface_ms << ",\n";
+    out << "    \"save\": " << _save_ms << "\n";
+    out << "  },\n";
+    out << "  \"errors\": [";
+    for (int i = 0; i < _errors.size(); ++i)
+      out << (i > 0 ? ", " : "") << "\"" << json_escape(_errors[i]) << "\"";
+    out << "]\n";
+    out << "}\n";
+
+    return out.status() == QTextStream::Ok;
+  }
+}
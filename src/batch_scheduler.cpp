@@ -0,0 +1,302 @@
+/** @file
+  * @copyright Copyright (c) 2013 PROFACTOR GmbH. All rights reserved. 
+  *
+  * Redistribution and use in source and binary forms, with or without
+  * modification, are permitted provided that the following conditions are
+  * met:
+  *
+  *     * Redistributions of source code must retain the above copyright
+  * notice, this list of conditions and the following disclaimer.
+  *     * Redistributions in binary form must reproduce the above
+  * copyright notice, this list of conditions and the following disclaimer
+  * in the documentation and/or other materials provided with the
+  * distribution.
+  *     * Neither the name of Profactor GmbH nor the names of its
+  * contributors may be used to endorse or promote products derived from
+  * this software without specific prior written permission.
+  *
+  * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  *
+  * @authors christoph.kopf@profactor.at
+  *          florian.eckerstorfer@profactor.at
+  */
+
+#include "batch_scheduler.h"
+#include "frame_player.h"
+
+#include <QSettings>
+#include <QThread>
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QRegExp>
+#include <QTextStream>
+
+#include <algorithm>
+#include <iostream>
+
+// Resolution the SDK uses when no configuration file is given
+#define DEFAULT_VOLUME_RESOLUTION 256
+
+namespace ReconstructMeGUI {
+
+  batch_scheduler::batch_scheduler(QObject *parent) :
+    QObject(parent),
+    _max_jobs(QThread::idealThreadCount()),
+    _memory_budget(1024LL * 1024 * 1024),
+    _memory_used(0),
+    _bytes_per_voxel(4),
+    _success(true)
+  {
+  }
+
+  batch_scheduler::~batch_scheduler() {
+    foreach(job_ptr j, _running) {
+      j->thread->quit();
+      j->thread->wait();
+      delete j->worker;
+    }
+  }
+
+  bool batch_scheduler::requested(const QStringList &args, QString &manifest) {
+    int i = args.indexOf("--batch-manifest");
+    if (i < 0 || i + 1 >= args.size())
+      return false;
+    manifest = args[i + 1];
+    return true;
+  }
+
+  bool batch_scheduler::succeeded() const {
+    return _success;
+  }
+
+  bool batch_scheduler::load_manifest(const QString &file_name, QString &error) {
+    if (!QFileInfo(file_name).isFile()) {
+      error = "Manifest " + file_name + " not found";
+      return false;
+    }
+
+    QSettings m(file_name, QSettings::IniFormat);
+    QDir base = QFileInfo(file_name).absoluteDir();
+
+    m.beginGroup("general");
+    _max_jobs = std::max(1, m.value("jobs", _max_jobs).toInt());
+    _memory_budget = m.value("memory_budget_mb", _memory_budget / (1024 * 1024)).toLongLong() * 1024 * 1024;
+    _bytes_per_voxel = m.value("bytes_per_voxel", _bytes_per_voxel).toInt();
+    if (m.contains("report"))
+      _report_path = base.absoluteFilePath(m.value("report").toString());
+    m.endGroup();
+
+    if (_bytes_per_voxel <= 0 || _memory_budget <= 0) {
+      error = "Manifest " + file_name + ": bytes_per_voxel and memory_budget_mb have to be positive";
+      return false;
+    }
+
+    foreach(const QString &name, m.childGroups()) {
+      if (name == "general")
+        continue;
+
+      m.beginGroup(name);
+      job_ptr j(new job());
+      batch_options &o = j->options;
+      o.name = name;
+      if (m.contains("sensor")) o.sensor_path = base.absoluteFilePath(m.value("sensor").toString());
+      if (m.contains("config")) o.config_path = base.absoluteFilePath(m.value("config").toString());
+      if (m.contains("license")) o.license_path = base.absoluteFilePath(m.value("license").toString());
+      if (m.contains("output")) o.output_path = base.absoluteFilePath(m.value("output").toString());
+      if (m.contains("report")) o.report_path = base.absoluteFilePath(m.value("report").toString());
+      o.device_id = m.value("device", o.device_id).toInt();
+      bool decimation_ok = true, frames_ok = true;
+      if (m.contains("decimation")) o.decimation = m.value("decimation").toFloat(&decimation_ok);
+      if (m.contains("frames")) o.max_frames = m.value("frames").toInt(&frames_ok);
+      frames_ok = frames_ok && (!m.contains("frames") || o.max_frames > 0);
+      m.endGroup();
+
+      if (o.output_path.isEmpty()) {
+        error = "Job " + name + " has no output";
+        return false;
+      }
+      if (!decimation_ok || o.decimation <= 0.f || o.decimation > 1.f) {
+        error = "Job " + name + ": decimation has to be in (0, 1]";
+        return false;
+      }
+      if (!frames_ok) {
+        error = "Job " + name + ": frames has to be a positive number";
+        return false;
+      }
+
+      j->volume_bytes = estimate_volume_bytes(o.config_path, _bytes_per_voxel);
+      j->num_frames = frame_player::count_frames(o.sensor_path);
+      if (j->num_frames < 0)
+        j->num_frames = o.max_frames > 0 ? o.max_frames : 1;
+      if (o.max_frames > 0)
+        j->num_frames = std::min(j->num_frames, o.max_frames);
+      j->cost = (double)(j->volume_bytes / _bytes_per_voxel) * j->num_frames;
+      j->thread = 0;
+      j->worker = 0;
+      j->success = false;
+      j->frames_processed = 0;
+      j->scan_ms = 0;
+
+      _pending.push_back(j);
+    }
+
+    // Most expensive jobs first, cheap ones fill the remaining slots
+    std::sort(_pending.begin(), _pending.end(), [](const job_ptr &a, const job_ptr &b) {
+      return a->cost > b->cost;
+    });
+
+    return true;
+  }
+
+  qint64 batch_scheduler::estimate_volume_bytes(const QString &config_path, int bytes_per_voxel) {
+    qint64 res[3] = { DEFAULT_VOLUME_RESOLUTION, DEFAULT_VOLUME_RESOLUTION, DEFAULT_VOLUME_RESOLUTION };
+
+    QFile f(config_path);
+    if (f.open(QIODevice::ReadOnly | QIODevice::Text)) {
+      const QString text = QTextStream(&f).readAll();
+      QRegExp block("resolution\\s*\\{([^}]*)\\}");
+      if (block.indexIn(text) >= 0) {
+        const QString body = block.cap(1);
+        const char *axes[3] = { "x", "y", "z" };
+        for (int i = 0; i < 3; ++i) {
+          QRegExp axis(QString("\\b%1\\s*:\\s*(\\d+)").arg(axes[i]));
+          if (axis.indexIn(body) >= 0)
+            res[i] = axis.cap(1).toLongLong();
+        }
+      }
+    }
+
+    return res[0] * res[1] * res[2] * bytes_per_voxel;
+  }
+
+  void batch_scheduler::run() {
+    _clock.start();
+    
+    // Jobs that can never fit are failed up front
+    for (int i = _pending.size() - 1; i >= 0; --i) {
+      if (_pending[i]->volume_bytes > _memory_budget) {
+        std::cerr << "[" << _pending[i]->options.name.toStdString() << "] Volume exceeds memory budget, skipped" << std::endl;
+        _done.push_back(_pending.takeAt(i));
+        _success = false;
+      }
+    }
+
+    schedule();
+  }
+
+  void batch_scheduler::schedule() {
+    for (int i = 0; i < _pending.size() && _running.size() < _max_jobs; ) {
+      job_ptr j = _pending[i];
+      if (_memory_used + j->volume_bytes > _memory_budget) {
+        ++i;
+        continue;
+      }
+
+      _pending.removeAt(i);
+      _memory_used += j->volume_bytes;
+
+      j->thread = new QThread(this);
+      j->worker = new batch_reconstruction(j->options);
+      j->worker->moveToThread(j->thread);
+      connect(j->worker, SIGNAL(finished(int)), SLOT(job_finished(int)), Qt::QueuedConnection);
+      j->thread->start();
+      QMetaObject::invokeMethod(j->worker, "run", Qt::QueuedConnection);
+
+      _running.push_back(j);
+    }
+
+    if (_running.isEmpty())
+      finish();
+  }
+
+  void batch_scheduler::job_finished(int exit_code) {
+    batch_reconstruction *worker = qobject_cast<batch_reconstruction*>(sender());
+
+    for (int i = 0; i < _running.size(); ++i) {
+      job_ptr j = _running[i];
+      if (j->worker != worker) 
+        continue;
+
+      j->thread->quit();
+      j->thread->wait();
+
+      j->success = exit_code == 0;
+      j->frames_processed = worker->num_frames();
+      j->scan_ms = worker->scan_ms();
+      _success = _success && j->success;
+
+      delete j->worker;
+      j->worker = 0;
+      delete j->thread;
+      j->thread = 0;
+
+      _memory_used -= j->volume_bytes;
+      _done.push_back(_running.takeAt(i));
+      break;
+    }
+
+    schedule();
+  }
+
+  void batch_scheduler::finish() {
+    qint64 frames = 0;
+    foreach(job_ptr j, _done) 
+      frames += j->frames_processed;
+    
+    const qint64 wall_ms = _clock.elapsed();
+    std::cerr << "Processed " << _done.size() << " jobs, " << frames << " frames in " << wall_ms << " ms, " 
+              << (wall_ms > 0 ? 1000.0 * frames / wall_ms : 0.0) << " frames/s" << std::endl;
+
+    if (!_report_path.isEmpty() && !write_report())
+      std::cerr << "Could not write report " << _report_path.toStdString() << std::endl;
+
+    emit finished(_success ? 0 : 1);
+  }
+
+  bool batch_scheduler::write_report() const {
+    QFile f(_report_path);
+    if (!f.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text))
+      return false;
+
+    qint64 frames = 0;
+    foreach(job_ptr j, _done) 
+      frames += j->frames_processed;
+    const qint64 wall_ms = _clock.elapsed();
+
+    QTextStream out(&f);
+    out << "{\n";
+    out << "  \"success\": " << (_success ? "true" : "false") << ",\n";
+    out << "  \"max_jobs\": " << _max_jobs << ",\n";
+    out << "  \"memory_budget_mb\": " << _memory_budget / (1024 * 1024) << ",\n";
+    out << "  \"wall_ms\": " << wall_ms << ",\n";
+    out << "  \"frames\": " << frames << ",\n";
+    out << "  \"fps\": " << (wall_ms > 0 ? 1000.0 * frames / wall_ms : 0.0) << ",\n";
+    out << "  \"jobs\": [\n";
+    for (int i = 0; i < _done.size(); ++i) {
+      const job &j = *_done[i];
+      out << "    { \"name\": \"" << json_escape(j.options.name) << "\""
+          << ", \"output\": \"" << json_escape(j.options.output_path) << "\""
+          << ", \"success\": " << (j.success ? "true" : "false")
+          << ", \"volume_mb\": " << j.volume_bytes / (1024 * 1024)
+          << ", \"frames\": " << j.frames_processed
+          << ", \"scan_ms\": " << j.scan_ms
+          << ", \"fps\": " << (j.scan_ms > 0 ? 1000.0 * j.frames_processed / j.scan_ms : 0.0)
+          << " }" << (i + 1 < _done.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n";
+    out << "}\n";
+
+    return out.status() == QTextStream::Ok;
+  }
+}
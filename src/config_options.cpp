@@ -0,0 +1,275 @@
+/** @file
+  * @copyright Copyright (c) 2013 PROFACTOR GmbH. All rights reserved. 
+  *
+  * Redistribution and use in source and binary forms, with or without
+  * modification, are permitted provided that the following conditions are
+  * met:
+  *
+  *     * Redistributions of source code must retain the above copyright
+  * notice, this list of conditions and the following disclaimer.
+  *     * Redistributions in binary form must reproduce the above
+  * copyright notice, this list of conditions and the following disclaimer
+  * in the documentation and/or other materials provided with the
+  * distribution.
+  *     * Neither the name of Profactor GmbH nor the names of its
+  * contributors may be used to endorse or promote products derived from
+  * this software without specific prior written permission.
+  *
+  * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  *
+  * @authors christoph.kopf@profactor.at
+  *          florian.eckerstorfer@profactor.at
+  */
+
+#include "config_options.h"
+
+#include <QFile>
+#include <QVector>
+#include <QPair>
+
+namespace ReconstructMeGUI {
+  namespace config_options {
+
+    namespace {
+      /** Options read by the SDK on every frame rather than at compile time */
+      const char* const live_prefixes[] = {
+        "tracking."
+      };
+
+      class tokenizer {
+      public:
+        tokenizer(const QString &text) : _text(text), _pos(0), _start(0), _line(1) {}
+
+        /** Next token, empty at the end of input */
+        QString next() {
+          skip_space();
+          _start = _pos;
+          if (_pos >= _text.size())
+            return QString();
+
+          const QChar c = _text[_pos];
+          if (c == '"' || c == '\'') 
+            return quoted(c);
+          if (QString("{}<>[]:,;").contains(c))
+            return QString(_text[_pos++]);
+
+          const int start = _pos;
+          while (_pos < _text.size() && !_text[_pos].isSpace() && !QString("{}<>[]:,;#\"'").contains(_text[_pos]))
+            _pos++;
+          return _text.mid(start, _pos - start);
+        }
+
+        QString peek() {
+          const int pos = _pos, start = _start, line = _line;
+          QString t = next();
+          _pos = pos;
+          _start = start;
+          _line = line;
+          return t;
+        }
+
+        int line() const { return _line; }
+        /** Offset of the token last returned by next */
+        int start() const { return _start; }
+
+      private:
+        void skip_space() {
+          while (_pos < _text.size()) {
+            if (_text[_pos] == '#') {
+              while (_pos < _text.size() && _text[_pos] != '\n')
+                _pos++;
+            } else if (_text[_pos].isSpace()) {
+              if (_text[_pos] == '\n')
+                _line++;
+              _pos++;
+            } else {
+              break;
+            }
+          }
+        }
+
+        /** Quoted strings are kept with their quotes, values are compared verbatim */
+        QString quoted(QChar q) {
+          const int start = _pos++;
+          while (_pos < _text.size() && _text[_pos] != q) {
+            if (_text[_pos] == '\\')
+              _pos++;
+            _pos++;
+          }
+          _pos++;
+          return _text.mid(start, _pos - start);
+        }
+
+        QString _text;
+        int _pos;
+        int _start;
+        int _line;
+      };
+
+      bool is_identifier(const QString &t) {
+        return !t.isEmpty() && (t[0].isLetter() || t[0] == '_');
+      }
+
+      /** Offset and length of each value in the text */
+      typedef QMap<QString, QPair<int, int> > spans_t;
+
+      QString insert(values_t &values, const QString &path, const QString &value) {
+        QString key = path;
+        if (values.contains(key) || values.contains(key + "[0]")) {
+          // Repeated field, index all occurrences
+          if (values.contains(key))
+            values.insert(key + "[0]", values.take(key));
+          int i = 1;
+          while (values.contains(QString("%1[%2]").arg(path).arg(i)))
+            i++;
+          key = QString("%1[%2]").arg(path).arg(i);
+        }
+        values.insert(key, value);
+        return key;
+      }
+
+      bool parse_fields(tokenizer &t, const QString &prefix, const QString &close, values_t &values, spans_t &spans, QString &error) {
+        while (true) {
+          QString name = t.next();
+          if (name == close)
+            return true;
+          if (name.isEmpty()) {
+            error = close.isEmpty() ? QString() : QString("Unexpected end of file, missing '%1'").arg(close);
+            return close.isEmpty();
+          }
+          if (name == "," || name == ";")
+            continue;
+          if (!is_identifier(name)) {
+            error = QString("Line %1: expected field name, got '%2'").arg(t.line()).arg(name);
+            return false;
+          }
+
+          const QString path = prefix.isEmpty() ? name : prefix + "." + name;
+          if (t.peek() == ":")
+            t.next();
+
+          const QString open = t.next();
+          if (open == "{" || open == "<") {
+            if (!parse_fields(t, path, open == "{" ? "}" : ">", values, spans, error))
+              return false;
+          } else if (open == "[") {
+            for (QString v = t.next(); v != "]"; v = t.next()) {
+              if (v.isEmpty()) {
+                error = QString("Line %1: unterminated list").arg(t.line());
+                return false;
+              }
+              if (v != ",")
+                spans.insert(insert(values, path, v), qMakePair(t.start(), v.size()));
+            }
+          } else if (open.isEmpty() || QString("}>:").contains(open)) {
+            error = QString("Line %1: expected value of '%2'").arg(t.line()).arg(path);
+            return false;
+          } else {
+            spans.insert(insert(values, path, open), qMakePair(t.start(), open.size()));
+          }
+        }
+      }
+    }
+
+    bool parse(const QString &text, values_t &values, QString &error) {
+      values.clear();
+      spans_t spans;
+      tokenizer t(text);
+      return parse_fields(t, QString(), QString(), values, spans, error);
+    }
+
+    bool rewrite(QString &text, const values_t &changes, QString &error) {
+      values_t values;
+      spans_t spans;
+      tokenizer t(text);
+      if (!parse_fields(t, QString(), QString(), values, spans, error))
+        return false;
+
+      // Replace existing values back to front to keep the offsets valid
+      QMap<int, QPair<int, QString> > replacements;
+      QString appended;
+      for (values_t::const_iterator i = changes.begin(); i != changes.end(); ++i) {
+        spans_t::const_iterator s = spans.find(i.key());
+        if (s != spans.end()) {
+          replacements.insert(s.value().first, qMakePair(s.value().second, i.value()));
+          continue;
+        }
+        if (i.key().contains('['))
+          continue;
+
+        // Message fields given more than once are merged by the parser
+        const QStringList parts = i.key().split('.');
+        QString line;
+        for (int p = 0; p < parts.size() - 1; ++p)
+          line += parts[p] + " { ";
+        line += parts.last() + ": " + i.value();
+        for (int p = 0; p < parts.size() - 1; ++p)
+          line += " }";
+        appended += line + "\n";
+      }
+
+      QMapIterator<int, QPair<int, QString> > r(replacements);
+      r.toBack();
+      while (r.hasPrevious()) {
+        r.previous();
+        text.replace(r.key(), r.value().first, r.value().second);
+      }
+      if (!appended.isEmpty()) {
+        if (!text.isEmpty() && !text.endsWith('\n'))
+          text += '\n';
+        text += appended;
+      }
+      return true;
+    }
+
+    bool parse_file(const QString &path, values_t &values, QString &error) {
+      QFile f(path);
+      if (!f.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        error = QString("Could not open %1").arg(path);
+        return false;
+      }
+      return parse(QString::fromUtf8(f.readAll()), values, error);
+    }
+
+    QStringList diff(const values_t &a, const values_t &b) {
+      QStringList changed;
+      for (values_t::const_iterator i = a.begin(); i != a.end(); ++i) {
+        values_t::const_iterator j = b.find(i.key());
+        if (j == b.end() || j.value() != i.value())
+          changed << i.key();
+      }
+      for (values_t::const_iterator j = b.begin(); j != b.end(); ++j) {
+        if (!a.contains(j.key()))
+          changed << j.key();
+      }
+      return changed;
+    }
+
+    bool is_live(const QString &path) {
+      if (path.contains('['))
+        return false;
+      for (size_t i = 0; i < sizeof(live_prefixes) / sizeof(live_prefixes[0]); ++i)
+        if (path.startsWith(live_prefixes[i]))
+          return true;
+      return false;
+    }
+
+    QString unquote(const QString &value) {
+      if (value.size() < 2 || (value[0] != '"' && value[0] != '\''))
+        return value;
+      QString v = value.mid(1, value.size() - 2);
+      v.replace("\\\"", "\"").replace("\\'", "'").replace("\\\\", "\\");
+      return v;
+    }
+  }
+}
@@ -0,0 +1,217 @@
+/** @file
+  * @copyright Copyright (c) 2013 PROFACTOR GmbH. All rights reserved. 
+  *
+  * Redistribution and use in source and binary forms, with or without
+  * modification, are permitted provided that the following conditions are
+  * met:
+  *
+  *     * Redistributions of source code must retain the above copyright
+  * notice, this list of conditions and the following disclaimer.
+  *     * Redistributions in binary form must reproduce the above
+  * copyright notice, this list of conditions and the following disclaimer
+  * in the documentation and/or other materials provided with the
+  * distribution.
+  *     * Neither the name of Profactor GmbH nor the names of its
+  * contributors may be used to endorse or promote products derived from
+  * this software without specific prior written permission.
+  *
+  * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  *
+  * @authors christoph.kopf@profactor.at
+  *          florian.eckerstorfer@profactor.at
+  */
+
+#include "config_tuner.h"
+#include "config_options.h"
+#include "settings.h"
+
+#include <QFile>
+#include <QElapsedTimer>
+
+#include <reconstructmesdk/reme.h>
+
+#include <sstream>
+#include <cstring>
+
+namespace ReconstructMeGUI {
+
+  static const int warmup_frames = 10;
+  /** Resolutions are scaled per axis and rounded to multiples of this */
+  static const int resolution_step = 16;
+  static const float scales[] = { 0.5f, 0.625f, 0.75f, 0.875f, 1.f, 1.25f, 1.5f, 1.75f, 2.f };
+
+  namespace {
+    int scaled(int r, float s) {
+      const int v = (int)(r * s / resolution_step + 0.5f) * resolution_step;
+      return v < resolution_step ? resolution_step : v;
+    }
+
+    std::string to_string(int v) {
+      std::stringstream str;
+      str << v;
+      return str.str();
+    }
+
+    /** Context with reconstruction options of config_path bound to o */
+    bool create_context(const QString &config_path, reme_context_t &c, reme_options_t &o) {
+      if (!REME_SUCCESS(reme_context_create(&c)))
+        return false;
+      bool success = REME_SUCCESS(reme_options_create(c, &o));
+      success = success && REME_SUCCESS(reme_context_bind_reconstruction_options(c, o));
+      if (success && config_path != config_path_default_tag)
+        success = REME_SUCCESS(reme_options_load_from_file(c, o, config_path.toStdString().c_str()));
+      if (!success)
+        reme_context_destroy(&c);
+      return success;
+    }
+  }
+
+  config_tuner::config_tuner(const QString &config_path, int device_id) :
+    _config_path(config_path), _device_id(device_id), _width(0), _height(0)
+  {}
+
+  void config_tuner::set_frame_size(int width, int height) {
+    _width = width;
+    _height = height;
+  }
+
+  void config_tuner::add_frame(const QByteArray &raw_depth) {
+    _frames.push_back(raw_depth);
+  }
+
+  int config_tuner::num_frames() const {
+    return _frames.size();
+  }
+
+  config_tuner::candidate config_tuner::tune(float target_fps, QVector<candidate> &measured) const {
+    measured.clear();
+
+    int x, y, z;
+    if (_frames.size() <= warmup_frames || !base_resolution(x, y, z))
+      return candidate();
+
+    candidate best;
+    for (size_t i = 0; i < sizeof(scales) / sizeof(scales[0]); ++i) {
+      candidate c;
+      c.x = scaled(x, scales[i]);
+      c.y = scaled(y, scales[i]);
+      c.z = scaled(z, scales[i]);
+      if (!measured.isEmpty() && c.x == measured.back().x && c.y == measured.back().y && c.z == measured.back().z)
+        continue;
+
+      measure(c);
+      measured.push_back(c);
+
+      // Frame rate drops with resolution, larger candidates will miss as well
+      if (c.fps < target_fps)
+        break;
+      best = c;
+    }
+    return best;
+  }
+
+  bool config_tuner::write(const QString &config_path, const candidate &c, const QString &path, QString &error) {
+    QString text;
+    if (config_path != config_path_default_tag) {
+      QFile in(config_path);
+      if (!in.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        error = "Could not open " + config_path;
+        return false;
+      }
+      text = QString::fromUtf8(in.readAll());
+    }
+
+    config_options::values_t changes;
+    changes.insert("volume.resolution.x", QString::number(c.x));
+    changes.insert("volume.resolution.y", QString::number(c.y));
+    changes.insert("volume.resolution.z", QString::number(c.z));
+    if (!config_options::rewrite(text, changes, error))
+      return false;
+
+    QFile out(path);
+    if (!out.open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Truncate)) {
+      error = "Could not write " + path;
+      return false;
+    }
+    out.write(text.toUtf8());
+    return true;
+  }
+
+  bool config_tuner::base_resolution(int &x, int &y, int &z) const {
+    reme_context_t c;
+    reme_options_t o;
+    if (!create_context(_config_path, c, o))
+      return false;
+
+    bool success = REME_SUCCESS(reme_options_get_int(c, o, "volume.resolution.x", &x));
+    success = success && REME_SUCCESS(reme_options_get_int(c, o, "volume.resolution.y", &y));
+    success = success && REME_SUCCESS(reme_options_get_int(c, o, "volume.resolution.z", &z));
+    reme_context_destroy(&c);
+    return success && x > 0 && y > 0 && z > 0;
+  }
+
+  void config_tuner::measure(candidate &c) const {
+    // Two 16 bit values per voxel, distance and weight
+    c.volume_mb = (int)((qint64)c.x * c.y * c.z * 4 / (1024 * 1024));
+    c.fps = -1.f;
+
+    reme_context_t ctx;
+    reme_options_t o;
+    if (!create_context(_config_path, ctx, o))
+      return;
+
+    bool success = REME_SUCCESS(reme_options_set(ctx, o, "volume.resolution.x", to_string(c.x).c_str()));
+    success = success && REME_SUCCESS(reme_options_set(ctx, o, "volume.resolution.y", to_string(c.y).c_str()));
+    success = success && REME_SUCCESS(reme_options_set(ctx, o, "volume.resolution.z", to_string(c.z).c_str()));
+    success = success && REME_SUCCESS(reme_options_set(ctx, o, "device_id", to_string(_device_id).c_str()));
+    success = success && REME_SUCCESS(reme_context_compile(ctx));
+
+    reme_volume_t v;
+    success = success && REME_SUCCESS(reme_volume_create(ctx, &v));
+
+    reme_sensor_t s;
+    success = success && REME_SUCCESS(reme_sensor_create(ctx, "external", true, &s));
+    success = success && REME_SUCCESS(reme_sensor_bind_capture_options(ctx, s, o));
+    success = success && REME_SUCCESS(reme_options_set(ctx, o, "frame_info.depth_size.width", to_string(_width).c_str()));
+    success = success && REME_SUCCESS(reme_options_set(ctx, o, "frame_info.depth_size.height", to_string(_height).c_str()));
+    success = success && REME_SUCCESS(reme_sensor_open(ctx, s));
+
+    reme_image_t depth;
+    success = success && REME_SUCCESS(reme_image_create(ctx, &depth));
+
+    QElapsedTimer t;
+    for (int i = 0; success && i < _frames.size(); ++i) {
+      if (i == warmup_frames)
+        t.start();
+
+      void *data;
+      int length;
+      success = success && REME_SUCCESS(reme_sensor_get_image(ctx, s, REME_IMAGE_RAW_DEPTH, depth));
+      success = success && REME_SUCCESS(reme_image_get_mutable_bytes(ctx, depth, &data, &length));
+      success = success && length == _frames[i].size();
+      if (!success)
+        break;
+      memcpy(data, _frames[i].constData(), length);
+
+      // Lost tracking is part of the measured workload
+      reme_sensor_track_position(ctx, s);
+      success = REME_SUCCESS(reme_sensor_update_volume(ctx, s));
+    }
+
+    const qint64 msecs = success ? t.elapsed() : 0;
+    reme_context_destroy(&ctx);
+
+    if (success)
+      c.fps = (_frames.size() - warmup_frames) * 1000.f / (msecs > 0 ? msecs : 1);
+  }
+}
@@ -0,0 +1,205 @@
+/** @file
+  * @copyright Copyright (c) 2013 PROFACTOR GmbH. All rights reserved. 
+  *
+  * Redistribution and use in source and binary forms, with or without
+  * modification, are permitted provided that the following conditions are
+  * met:
+  *
+  *     * Redistributions of source code must retain the above copyright
+  * notice, this list of conditions and the following disclaimer.
+  *     * Redistributions in binary form must reproduce the above
+  * copyright notice, this list of conditions and the following disclaimer
+  * in the documentation and/or other materials provided with the
+  * distribution.
+  *     * Neither the name of Profactor GmbH nor the names of its
+  * contributors may be used to endorse or promote products derived from
+  * this software without specific prior written permission.
+  *
+  * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  *
+  * @authors christoph.kopf@profactor.at
+  *          florian.eckerstorfer@profactor.at
+  */
+
+#include "device_profile.h"
+#include "settings.h"
+#include "settings_store.h"
+
+#include <QSettings>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QElapsedTimer>
+#include <QVector>
+#include <QCryptographicHash>
+
+#include <reconstructmesdk/reme.h>
+
+#include <sstream>
+#include <cstring>
+#include <cmath>
+
+namespace ReconstructMeGUI {
+
+  static const int warmup_frames = 5;
+  static const int measured_frames = 30;
+  static const int depth_width = 640;
+  static const int depth_height = 480;
+
+  /** Batch workers of one process share the profile file */
+  static QMutex profile_mutex;
+
+  device_profile::device_profile(const QString &path) : _path(path)
+  {}
+
+  QString device_profile::default_path() {
+    return settings_store::instance().directory() + "/device_profile.ini";
+  }
+
+  QString device_profile::volume_resolution(reme_context_t c, reme_options_t o) {
+    int x = 0, y = 0, z = 0;
+    reme_options_get_int(c, o, "volume.resolution.x", &x);
+    reme_options_get_int(c, o, "volume.resolution.y", &y);
+    reme_options_get_int(c, o, "volume.resolution.z", &z);
+    return QString("%1x%2x%3").arg(x).arg(y).arg(z);
+  }
+
+  void device_profile::validate(const QString &sdk_version) {
+    QMutexLocker lock(&profile_mutex);
+    QSettings profile(_path, QSettings::IniFormat);
+    if (profile.value("sdk_version").toString() != sdk_version) {
+      profile.clear();
+      profile.setValue("sdk_version", sdk_version);
+    }
+  }
+
+  float device_profile::fps(const QString &device_name, const QString &resolution) const {
+    QMutexLocker lock(&profile_mutex);
+    QSettings profile(_path, QSettings::IniFormat);
+    return profile.value("fps/" + key(device_name, resolution), -1.f).toFloat();
+  }
+
+  void device_profile::insert(const QString &device_name, const QString &resolution, float fps) {
+    QMutexLocker lock(&profile_mutex);
+    QSettings profile(_path, QSettings::IniFormat);
+    profile.setValue("fps/" + key(device_name, resolution), fps);
+  }
+
+  int device_profile::best_device(const opencl_info &ocl, const QString &resolution) const {
+    int best = -1;
+    float best_fps = 0.f;
+    for (int i = 0; i < ocl.devices_size(); ++i) {
+      const float f = fps(QString::fromStdString(ocl.devices(i).name()), resolution);
+      if (f < 0.f)
+        return -1;
+      if (f > best_fps) {
+        best = i;
+        best_fps = f;
+      }
+    }
+    return best;
+  }
+
+  QString device_profile::key(const QString &device_name, const QString &resolution) {
+    // Device names contain characters QSettings treats as separators
+    QCryptographicHash h(QCryptographicHash::Sha1);
+    h.addData(device_name.trimmed().toUtf8());
+    h.addData(resolution.toUtf8());
+    return h.result().toHex();
+  }
+
+  float device_profile::measure(int device_id, const QString &config_path, QString &resolution) {
+    reme_context_t c;
+    if (!REME_SUCCESS(reme_context_create(&c)))
+      return -1.f;
+
+    reme_options_t o;
+    bool success = REME_SUCCESS(reme_options_create(c, &o));
+    success = success && REME_SUCCESS(reme_context_bind_reconstruction_options(c, o));
+    if (success && config_path != config_path_default_tag)
+      success = REME_SUCCESS(reme_options_load_from_file(c, o, config_path.toStdString().c_str()));
+
+    std::stringstream str_device;
+    str_device << device_id;
+    success = success && REME_SUCCESS(reme_options_set(c, o, "device_id", str_device.str().c_str()));
+    if (success)
+      resolution = volume_resolution(c, o);
+    success = success && REME_SUCCESS(reme_context_compile(c));
+
+    reme_volume_t v;
+    success = success && REME_SUCCESS(reme_volume_create(c, &v));
+
+    // Synthetic depth is fed through an external sensor, as for replayed recordings
+    reme_sensor_t s;
+    success = success && REME_SUCCESS(reme_sensor_create(c, "external", true, &s));
+    success = success && REME_SUCCESS(reme_sensor_bind_capture_options(c, s, o));
+
+    std::stringstream str_w, str_h;
+    str_w << depth_width;
+    str_h << depth_height;
+    success = success && REME_SUCCESS(reme_options_set(c, o, "frame_info.depth_size.width", str_w.str().c_str()));
+    success = success && REME_SUCCESS(reme_options_set(c, o, "frame_info.depth_size.height", str_h.str().c_str()));
+    success = success && REME_SUCCESS(reme_sensor_open(c, s));
+
+    reme_image_t depth;
+    success = success && REME_SUCCESS(reme_image_create(c, &depth));
+
+    // Sphere in front of a wall, shifted per frame so tracking has work to do.
+    // Built up front so only the SDK calls are timed.
+    QVector<QVector<unsigned short> > frames(8);
+    for (int f = 0; f < frames.size(); ++f) {
+      QVector<unsigned short> &d = frames[f];
+      d.resize(depth_width * depth_height);
+      const float cx = depth_width * 0.5f + 5.f * f, cy = depth_height * 0.5f;
+      for (int y = 0; y < depth_height; ++y) {
+        for (int x = 0; x < depth_width; ++x) {
+          const float dx = (x - cx) / 150.f, dy = (y - cy) / 150.f;
+          const float r2 = dx * dx + dy * dy;
+          d[y * depth_width + x] = (unsigned short)(r2 < 1.f ? 900.f - 200.f * std::sqrt(1.f - r2) : 1100.f);
+        }
+      }
+    }
+
+    QElapsedTimer t;
+    qint64 nsecs = 0;
+    for (int i = 0; success && i < warmup_frames + measured_frames; ++i) {
+      const bool timed = i >= warmup_frames;
+
+      void *data;
+      int length;
+      t.start();
+      success = success && REME_SUCCESS(reme_sensor_get_image(c, s, REME_IMAGE_RAW_DEPTH, depth));
+      success = success && REME_SUCCESS(reme_image_get_mutable_bytes(c, depth, &data, &length));
+      if (timed)
+        nsecs += t.nsecsElapsed();
+      success = success && length == depth_width * depth_height * (int)sizeof(unsigned short);
+      if (!success)
+        break;
+
+      const QVector<unsigned short> &frame = frames[i % frames.size()];
+      std::memcpy(data, frame.constData(), length);
+
+      // Tracking raycasts the volume, failures on the first frames are expected
+      t.start();
+      reme_sensor_track_position(c, s);
+      success = REME_SUCCESS(reme_sensor_update_volume(c, s));
+      if (timed)
+        nsecs += t.nsecsElapsed();
+    }
+
+    reme_context_destroy(&c);
+
+    if (!success)
+      return -1.f;
+    return measured_frames * 1e9f / (nsecs > 0 ? nsecs : 1);
+  }
+}
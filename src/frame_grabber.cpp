@@ -1,141 +1,256 @@
-/** @file
-  * @copyright Copyright (c) 2013 PROFACTOR GmbH. All rights reserved. 
-  *
-  * Redistribution and use in source and binary forms, with or without
-  * modification, are permitted provided that the following conditions are
-  * met:
-  *
-  *     * Redistributions of source code must retain the above copyright
-  * notice, this list of conditions and the following disclaimer.
-  *     * Redistributions in binary form must reproduce the above
-  * copyright notice, this list of conditions and the following disclaimer
-  * in the documentation and/or other materials provided with the
-  * distribution.
-  *     * Neither the name of Profactor GmbH nor the names of its
-  * contributors may be used to endorse or promote products derived from
-  * this software without specific prior written permission.
-  *
-  * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
-  * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
-  * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
-  * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
-  * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
-  * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
-  * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
-  * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
-  * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
-  * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
-  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
-  *
-  * @authors christoph.kopf@profactor.at
-  *          florian.eckerstorfer@profactor.at
-  */
-
-#include "frame_grabber.h"
-#include "reme_resource_manager.h"
-
-#include <reconstructmesdk/reme.h>
-
-#include <QCoreApplication>
-#include <qdebug.h>
-
-#include <iostream>
-
-
-namespace ReconstructMeGUI {
-  frame_grabber::frame_grabber(std::shared_ptr<reme_resource_manager> rm) : 
-    _rm(rm)
-  {
-    _req_count[REME_IMAGE_AUX] = 0;
-    _req_count[REME_IMAGE_DEPTH] = 0;
-    _req_count[REME_IMAGE_VOLUME] = 0;
-
-    qRegisterMetaType<reme_sensor_image_t>("reme_sensor_image_t");
-
-    connect(_rm.get(), SIGNAL(initializing_sdk()), SLOT(stop()));
-    connect(_rm.get(), SIGNAL(sdk_initialized(bool)), SLOT(start(bool)));
-  }
-    
-  frame_grabber::~frame_grabber() {
-  }
-
-  bool frame_grabber::is_grabbing() {
-    return _do_grab;
-  }
-
-  void frame_grabber::request(reme_image_t image)
-  {
-    _req_count[image] += 1;
-  }
-
-  void frame_grabber::release(reme_image_t image)
-  {
-    _req_count[image] = std::max<int>(0, _req_count[image] - 1);
-  }
-
-  void frame_grabber::start(bool initialization_success) {
-    if (!initialization_success) return;
-
-    bool has_aux = false, has_depth = false, has_volume = false;
-
-    reme_sensor_is_image_supported(_rm->context(), _rm->sensor(), REME_IMAGE_AUX, &has_aux);
-    reme_sensor_is_image_supported(_rm->context(), _rm->sensor(), REME_IMAGE_DEPTH, &has_depth);
-    reme_sensor_is_image_supported(_rm->context(), _rm->sensor(), REME_IMAGE_VOLUME, &has_volume);
-
-    // Image creation
-    reme_image_create(_rm->context(), &_rgb);
-    reme_image_create(_rm->context(), &_depth);
-    reme_image_create(_rm->context(), &_phong);
-
-    // Grabbing utils
-    _do_grab = true;
-    bool success = true;
-
-    while (_do_grab && success)
-    {
-      // Prepare image and depth data
-      reme_error_t err = reme_sensor_grab(_rm->context(), _rm->sensor());
-
-      success = REME_SUCCESS(err);
-
-      if (success && has_aux && _req_count[REME_IMAGE_AUX] > 0) {
-        const void* data;
-        int length, width, height, channels, num_bytes_per_channel, row_stride;
-        reme_sensor_prepare_image(_rm->context(), _rm->sensor(), REME_IMAGE_AUX);
-        reme_sensor_get_image(_rm->context(), _rm->sensor(), REME_IMAGE_AUX, _rgb);
-        reme_image_get_bytes(_rm->context(), _rgb, &data, &length);
-        reme_image_get_info(_rm->context(), _rgb, &width, &height, &channels, &num_bytes_per_channel, &row_stride);
-        emit frame(REME_IMAGE_AUX, data, length, width, height, channels, num_bytes_per_channel, row_stride);
-      }
-
-      if (success && has_depth && _req_count[REME_IMAGE_DEPTH] > 0) {
-        const void* data;
-        int length, width, height, channels, num_bytes_per_channel, row_stride;
-        reme_sensor_prepare_image(_rm->context(), _rm->sensor(), REME_IMAGE_DEPTH);
-        reme_sensor_get_image(_rm->context(), _rm->sensor(), REME_IMAGE_DEPTH, _depth);
-        reme_image_get_bytes(_rm->context(), _depth, &data, &length);
-        reme_image_get_info(_rm->context(), _depth, &width, &height, &channels, &num_bytes_per_channel, &row_stride);
-        emit frame(REME_IMAGE_DEPTH, data, length, width, height, channels, num_bytes_per_channel, row_stride);        
-      }
-
-      if (success && has_volume && _req_count[REME_IMAGE_VOLUME] > 0) {
-        const void* data;
-        int length, width, height, channels, num_bytes_per_channel, row_stride;
-        reme_sensor_prepare_image(_rm->context(), _rm->sensor(), REME_IMAGE_VOLUME);
-        reme_sensor_get_image(_rm->context(), _rm->sensor(), REME_IMAGE_VOLUME, _phong);
-        reme_image_get_bytes(_rm->context(), _phong, &data, &length);
-        reme_image_get_info(_rm->context(), _phong, &width, &height, &channels, &num_bytes_per_channel, &row_stride);
-        emit frame(REME_IMAGE_VOLUME, data, length, width, height, channels, num_bytes_per_channel, row_stride);        
-      }      
-
-      emit frames_updated();  
-      QCoreApplication::processEvents();
-    }
-
-    emit stopped_grabbing();
-  }
-
-  void frame_grabber::stop() {
-    _do_grab = false;
-  }
+/** @file
+  * @copyright Copyright (c) 2013 PROFACTOR GmbH. All rights reserved. 
+  *
+  * Redistribution and use in source and binary forms, with or without
+  * modification, are permitted provided that the following conditions are
+  * met:
+  *
+  *     * Redistributions of source code must retain the above copyright
+  * notice, this list of conditions and the following disclaimer.
+  *     * Redistributions in binary form must reproduce the above
+  * copyright notice, this list of conditions and the following disclaimer
+  * in the documentation and/or other materials provided with the
+  * distribution.
+  *     * Neither the name of Profactor GmbH nor the names of its
+  * contributors may be used to endorse or promote products derived from
+  * this software without specific prior written permission.
+  *
+  * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  *
+  * @authors christoph.kopf@profactor.at
+  *          florian.eckerstorfer@profactor.at
+  */
+
+#include "frame_grabber.h"
+#include "reme_resource_manager.h"
+#include "frame_recorder.h"
+#include "frame_player.h"
+
+#include <reconstructmesdk/reme.h>
+
+#include <QCoreApplication>
+#include <qdebug.h>
+
+#include <iostream>
+#include <cstring>
+
+
+namespace ReconstructMeGUI {
+  frame_grabber::frame_grabber(std::shared_ptr<reme_resource_manager> rm) : 
+    _rm(rm),
+    _capture_request(0),
+    _capture_remaining(0),
+    _captured_width(0),
+    _captured_height(0)
+  {
+    _req_count[REME_IMAGE_AUX] = 0;
+    _req_count[REME_IMAGE_DEPTH] = 0;
+    _req_count[REME_IMAGE_VOLUME] = 0;
+
+    qRegisterMetaType<reme_sensor_image_t>("reme_sensor_image_t");
+    qRegisterMetaType<QVector<QByteArray> >("QVector<QByteArray>");
+
+    connect(_rm.get(), SIGNAL(initializing_sdk()), SLOT(stop()));
+    connect(_rm.get(), SIGNAL(sdk_initialized(bool)), SLOT(start(bool)));
+  }
+    
+  frame_grabber::~frame_grabber() {
+  }
+
+  bool frame_grabber::is_grabbing() {
+    return _do_grab;
+  }
+
+  void frame_grabber::request(reme_image_t image)
+  {
+    _req_count[image] += 1;
+  }
+
+  void frame_grabber::release(reme_image_t image)
+  {
+    _req_count[image] = std::max<int>(0, _req_count[image] - 1);
+  }
+
+  std::shared_ptr<frame_recorder> frame_grabber::recorder() const
+  {
+    return _recorder;
+  }
+
+  void frame_grabber::set_recorder(std::shared_ptr<frame_recorder> recorder)
+  {
+    _recorder = recorder;
+  }
+
+  void frame_grabber::capture_raw_depth(int num_frames)
+  {
+    _capture_request.fetchAndStoreRelease(num_frames);
+  }
+
+  void frame_grabber::finish_capture()
+  {
+    const QVector<QByteArray> frames = _captured;
+    _captured.clear();
+    _capture_remaining = 0;
+    emit raw_depth_captured(frames, _captured_width, _captured_height);
+  }
+
+  void frame_grabber::start(bool initialization_success) {
+    if (!initialization_success) return;
+
+    bool has_aux = false, has_depth = false, has_volume = false;
+
+    reme_sensor_is_image_supported(_rm->context(), _rm->sensor(), REME_IMAGE_AUX, &has_aux);
+    reme_sensor_is_image_supported(_rm->context(), _rm->sensor(), REME_IMAGE_DEPTH, &has_depth);
+    reme_sensor_is_image_supported(_rm->context(), _rm->sensor(), REME_IMAGE_VOLUME, &has_volume);
+
+    // Replayed AUX images do not pass through the sensor
+    std::shared_ptr<frame_player> player = _rm->player();
+    if (player) 
+      has_aux = false;
+
+    // Image creation, replaces the images of a previous run
+    _rgb.create(_rm->context(), &reme_image_create);
+    _depth.create(_rm->context(), &reme_image_create);
+    _phong.create(_rm->context(), &reme_image_create);
+    _raw_depth.create(_rm->context(), &reme_image_create);
+
+    // Grabbing utils
+    _do_grab = true;
+    bool success = true;
+
+    while (_do_grab && success)
+    {
+      const int capture_request = _capture_request.fetchAndStoreAcquire(0);
+      if (capture_request > 0) {
+        _captured.clear();
+        _capture_remaining = capture_request;
+      }
+
+      // Prepare image and depth data
+      recording::frame replayed;
+      if (player)
+        success = player->next_frame(replayed) && feed_sensor(replayed);
+      else
+        success = REME_SUCCESS(reme_sensor_grab(_rm->context(), _rm->sensor()));
+
+      const bool record = success && _recorder && _recorder->is_recording();
+      if (record) 
+        _recorder->begin_frame();
+
+      if (success && player) {
+        for (int i = 0; i < replayed.images.size(); ++i) {
+          const recording::image &img = replayed.images[i];
+          if (img.type != REME_IMAGE_AUX)
+            continue;
+          if (record)
+            _recorder->add_image(REME_IMAGE_AUX, img.data.constData(), img.data.size(), img.width, img.height, img.channels, img.num_bytes_per_channel, img.row_stride);
+          if (_req_count[REME_IMAGE_AUX] > 0)
+            emit frame(REME_IMAGE_AUX, img.data.constData(), img.data.size(), img.width, img.height, img.channels, img.num_bytes_per_channel, img.row_stride);
+        }
+      }
+
+      if (success && has_aux && (_req_count[REME_IMAGE_AUX] > 0 || record)) {
+        const void* data;
+        int length, width, height, channels, num_bytes_per_channel, row_stride;
+        reme_sensor_prepare_image(_rm->context(), _rm->sensor(), REME_IMAGE_AUX);
+        reme_sensor_get_image(_rm->context(), _rm->sensor(), REME_IMAGE_AUX, _rgb.get());
+        reme_image_get_bytes(_rm->context(), _rgb.get(), &data, &length);
+        reme_image_get_info(_rm->context(), _rgb.get(), &width, &height, &channels, &num_bytes_per_channel, &row_stride);
+        if (record)
+          _recorder->add_image(REME_IMAGE_AUX, data, length, width, height, channels, num_bytes_per_channel, row_stride);
+        if (_req_count[REME_IMAGE_AUX] > 0)
+          emit frame(REME_IMAGE_AUX, data, length, width, height, channels, num_bytes_per_channel, row_stride);
+      }
+
+      if (success && (record || _capture_remaining > 0)) {
+        // Raw sensor depth is what a replay feeds back into the pipeline
+        const void* data;
+        int length, width, height, channels, num_bytes_per_channel, row_stride;
+        reme_sensor_get_image(_rm->context(), _rm->sensor(), REME_IMAGE_RAW_DEPTH, _raw_depth.get());
+        reme_image_get_bytes(_rm->context(), _raw_depth.get(), &data, &length);
+        reme_image_get_info(_rm->context(), _raw_depth.get(), &width, &height, &channels, &num_bytes_per_channel, &row_stride);
+        if (record)
+          _recorder->add_image(REME_IMAGE_RAW_DEPTH, data, length, width, height, channels, num_bytes_per_channel, row_stride);
+        if (_capture_remaining > 0) {
+          _captured.push_back(QByteArray(static_cast<const char*>(data), length));
+          _captured_width = width;
+          _captured_height = height;
+          if (--_capture_remaining == 0)
+            finish_capture();
+        }
+      }
+
+      if (success && has_depth && _req_count[REME_IMAGE_DEPTH] > 0) {
+        const void* data;
+        int length, width, height, channels, num_bytes_per_channel, row_stride;
+        reme_sensor_prepare_image(_rm->context(), _rm->sensor(), REME_IMAGE_DEPTH);
+        reme_sensor_get_image(_rm->context(), _rm->sensor(), REME_IMAGE_DEPTH, _depth.get());
+        reme_image_get_bytes(_rm->context(), _depth.get(), &data, &length);
+        reme_image_get_info(_rm->context(), _depth.get(), &width, &height, &channels, &num_bytes_per_channel, &row_stride);
+        emit frame(REME_IMAGE_DEPTH, data, length, width, height, channels, num_bytes_per_channel, row_stride);        
+      }
+
+      if (success && has_volume && _req_count[REME_IMAGE_VOLUME] > 0) {
+        const void* data;
+        int length, width, height, channels, num_bytes_per_channel, row_stride;
+        reme_sensor_prepare_image(_rm->context(), _rm->sensor(), REME_IMAGE_VOLUME);
+        reme_sensor_get_image(_rm->context(), _rm->sensor(), REME_IMAGE_VOLUME, _phong.get());
+        reme_image_get_bytes(_rm->context(), _phong.get(), &data, &length);
+        reme_image_get_info(_rm->context(), _phong.get(), &width, &height, &channels, &num_bytes_per_channel, &row_stride);
+        emit frame(REME_IMAGE_VOLUME, data, length, width, height, channels, num_bytes_per_channel, row_stride);        
+      }      
+
+      emit frames_updated();  
+      QCoreApplication::processEvents();
+    }
+
+    // Hand out what was captured so far, nobody waits for a stopped loop
+    if (_capture_request.fetchAndStoreAcquire(0) > 0 || _capture_remaining > 0)
+      finish_capture();
+
+    release_images();
+    emit stopped_grabbing();
+  }
+
+  bool frame_grabber::feed_sensor(const recording::frame &f) {
+    for (int i = 0; i < f.images.size(); ++i) {
+      const recording::image &img = f.images[i];
+      if (img.type != REME_IMAGE_RAW_DEPTH)
+        continue;
+
+      void *data;
+      int length;
+      bool success = REME_SUCCESS(reme_sensor_get_image(_rm->context(), _rm->sensor(), REME_IMAGE_RAW_DEPTH, _raw_depth.get()));
+      success = success && REME_SUCCESS(reme_image_get_mutable_bytes(_rm->context(), _raw_depth.get(), &data, &length));
+      if (!success || length != img.data.size())
+        return false;
+
+      memcpy(data, img.data.constData(), length);
+      return true;
+    }
+    return false;
+  }
+
+  void frame_grabber::stop() {
+    _do_grab = false;
+    // Runs before the context is rebuilt, the grab loop does not touch the images after stop
+    release_images();
+  }
+
+  void frame_grabber::release_images() {
+    _rgb.reset();
+    _depth.reset();
+    _phong.reset();
+    _raw_depth.reset();
+  }
 }
\ No newline at end of file
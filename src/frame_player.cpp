@@ -0,0 +1,283 @@
+/** @file
+  * @copyright Copyright (c) 2013 PROFACTOR GmbH. All rights reserved. 
+  *
+  * Redistribution and use in source and binary forms, with or without
+  * modification, are permitted provided that the following conditions are
+  * met:
+  *
+  *     * Redistributions of source code must retain the above copyright
+  * notice, this list of conditions and the following disclaimer.
+  *     * Redistributions in binary form must reproduce the above
+  * copyright notice, this list of conditions and the following disclaimer
+  * in the documentation and/or other materials provided with the
+  * distribution.
+  *     * Neither the name of Profactor GmbH nor the names of its
+  * contributors may be used to endorse or promote products derived from
+  * this software without specific prior written permission.
+  *
+  * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  *
+  * @authors christoph.kopf@profactor.at
+  *          florian.eckerstorfer@profactor.at
+  */
+
+#include "frame_player.h"
+
+#include <QMutexLocker>
+#include <QtEndian>
+
+#include <cstring>
+
+#define PREFETCH_FRAMES 8
+
+namespace ReconstructMeGUI {
+
+  frame_player::frame_player(QObject *parent) :
+    QThread(parent),
+    _map(0),
+    _map_size(0),
+    _mode(REALTIME),
+    _stop_requested(false),
+    _prefetch_done(true),
+    _first_timestamp_us(-1)
+  {
+  }
+
+  frame_player::~frame_player() {
+    close();
+  }
+
+  bool frame_player::open(const QString &file_name, replay_mode_t mode) {
+    if (!load(file_name))
+      return false;
+
+    _mode = mode;
+    _stop_requested = false;
+    _prefetch_done = false;
+    _first_timestamp_us = -1;
+    start();
+    return true;
+  }
+
+  int frame_player::count_frames(const QString &file_name) {
+    frame_player p;
+    return p.load(file_name) ? p.num_frames() : -1;
+  }
+
+  bool frame_player::load(const QString &file_name) {
+    close();
+
+    _file.setFileName(file_name);
+    if (!_file.open(QIODevice::ReadOnly))
+      return false;
+
+    _map_size = _file.size();
+    _map = _file.map(0, _map_size);
+    if (_map == 0 || _map_size < recording::magic_size || memcmp(_map, recording::magic, recording::magic_size) != 0) {
+      close();
+      return false;
+    }
+
+    quint32 type, size;
+    const uchar *payload;
+    if (!read_chunk(recording::magic_size, type, payload, size) || 
+        type != recording::CHUNK_HEADER || 
+        !_header.ParseFromArray(payload, size)) 
+    {
+      close();
+      return false;
+    }
+
+    if (!read_index() && !rebuild_index()) {
+      close();
+      return false;
+    }
+
+    return true;
+  }
+
+  void frame_player::close() {
+    {
+      QMutexLocker lock(&_mutex);
+      _stop_requested = true;
+      _queue_not_full.wakeAll();
+    }
+    wait();
+
+    _queue.clear();
+    _offsets.clear();
+    _header.Clear();
+    if (_map != 0) 
+      _file.unmap(const_cast<uchar*>(_map));
+    _map = 0;
+    _map_size = 0;
+    _file.close();
+  }
+
+  int frame_player::num_frames() const {
+    return _offsets.size();
+  }
+
+  const recording_header &frame_player::header() const {
+    return _header;
+  }
+
+  bool frame_player::image_size(int type, int &width, int &height) const {
+    if (_offsets.isEmpty())
+      return false;
+
+    quint32 chunk_type, size;
+    const uchar *payload;
+    recorded_frame msg;
+    if (!read_chunk(_offsets.first(), chunk_type, payload, size) || !msg.ParseFromArray(payload, size))
+      return false;
+
+    for (int i = 0; i < msg.images_size(); ++i) {
+      if (msg.images(i).type() == type) {
+        width = msg.images(i).width();
+        height = msg.images(i).height();
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool frame_player::next_frame(recording::frame &f) {
+    {
+      QMutexLocker lock(&_mutex);
+      while (_queue.isEmpty() && !_prefetch_done)
+        _queue_not_empty.wait(&_mutex);
+
+      if (_queue.isEmpty())
+        return false;
+
+      f = _queue.dequeue();
+      _queue_not_full.wakeOne();
+    }
+
+    if (_mode == REALTIME) {
+      if (_first_timestamp_us < 0) {
+        _first_timestamp_us = f.timestamp_us;
+        _clock.start();
+      }
+      
+      const qint64 due_us = f.timestamp_us - _first_timestamp_us;
+      const qint64 now_us = _clock.nsecsElapsed() / 1000;
+      if (due_us > now_us)
+        QThread::usleep((unsigned long)(due_us - now_us));
+    }
+
+    return true;
+  }
+
+  void frame_player::run() {
+    for (int i = 0; i < _offsets.size(); ++i) {
+      recording::frame f;
+      if (!decode_frame(_offsets[i], f))
+        continue;
+
+      QMutexLocker lock(&_mutex);
+      while (_queue.size() >= PREFETCH_FRAMES && !_stop_requested)
+        _queue_not_full.wait(&_mutex);
+
+      if (_stop_requested)
+        break;
+
+      _queue.enqueue(f);
+      _queue_not_empty.wakeOne();
+    }
+
+    QMutexLocker lock(&_mutex);
+    _prefetch_done = true;
+    _queue_not_empty.wakeAll();
+  }
+
+  bool frame_player::read_chunk(qint64 offset, quint32 &type, const uchar *&payload, quint32 &size) const {
+    if (offset < 0 || offset + recording::chunk_header_size > _map_size)
+      return false;
+
+    type = qFromLittleEndian<quint32>(_map + offset);
+    size = qFromLittleEndian<quint32>(_map + offset + 4);
+    payload = _map + offset + recording::chunk_header_size;
+
+    return offset + recording::chunk_header_size + size <= _map_size;
+  }
+
+  bool frame_player::read_index() {
+    if (_map_size < recording::magic_size + recording::trailer_size)
+      return false;
+
+    const uchar *trailer = _map + _map_size - recording::trailer_size;
+    if (memcmp(trailer + 8, recording::trailer_magic, recording::magic_size) != 0)
+      return false;
+
+    quint32 type, size;
+    const uchar *payload;
+    recording_index index;
+    const qint64 offset = (qint64)qFromLittleEndian<quint64>(trailer);
+    if (!read_chunk(offset, type, payload, size) || type != recording::CHUNK_INDEX || !index.ParseFromArray(payload, size))
+      return false;
+
+    _offsets.resize(index.frames_size());
+    for (int i = 0; i < index.frames_size(); ++i)
+      _offsets[i] = index.frames(i).offset();
+    
+    return true;
+  }
+
+  bool frame_player::rebuild_index() {
+    // Recording was not closed properly, walk all complete chunks
+    _offsets.clear();
+
+    quint32 type, size;
+    const uchar *payload;
+    qint64 offset = recording::magic_size;
+    while (read_chunk(offset, type, payload, size)) {
+      if (type == recording::CHUNK_FRAME)
+        _offsets.push_back(offset);
+      offset += recording::chunk_header_size + size;
+    }
+
+    return true;
+  }
+
+  bool frame_player::decode_frame(qint64 offset, recording::frame &f) const {
+    quint32 type, size;
+    const uchar *payload;
+    recorded_frame msg;
+    if (!read_chunk(offset, type, payload, size) || type != recording::CHUNK_FRAME || !msg.ParseFromArray(payload, size))
+      return false;
+
+    f.timestamp_us = msg.timestamp_us();
+    f.track_success = msg.track_success();
+    f.pose.resize(msg.pose_size());
+    for (int i = 0; i < msg.pose_size(); ++i)
+      f.pose[i] = msg.pose(i);
+
+    f.images.resize(msg.images_size());
+    for (int i = 0; i < msg.images_size(); ++i) {
+      const recorded_image &src = msg.images(i);
+      recording::image &dst = f.images[i];
+      dst.type = src.type();
+      dst.width = src.width();
+      dst.height = src.height();
+      dst.channels = src.channels();
+      dst.num_bytes_per_channel = src.num_bytes_per_channel();
+      dst.row_stride = src.row_stride();
+      if (!recording::decode_image(src, dst.data))
+        return false;
+    }
+
+    return true;
+  }
+}
@@ -0,0 +1,239 @@
+/** @file
+  * @copyright Copyright (c) 2013 PROFACTOR GmbH. All rights reserved. 
+  *
+  * Redistribution and use in source and binary forms, with or without
+  * modification, are permitted provided that the following conditions are
+  * met:
+  *
+  *     * Redistributions of source code must retain the above copyright
+  * notice, this list of conditions and the following disclaimer.
+  *     * Redistributions in binary form must reproduce the above
+  * copyright notice, this list of conditions and the following disclaimer
+  * in the documentation and/or other materials provided with the
+  * distribution.
+  *     * Neither the name of Profactor GmbH nor the names of its
+  * contributors may be used to endorse or promote products derived from
+  * this software without specific prior written permission.
+  *
+  * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  *
+  * @authors christoph.kopf@profactor.at
+  *          florian.eckerstorfer@profactor.at
+  */
+
+#include "frame_recorder.h"
+#include "settings.h"
+#include "settings_store.h"
+
+#include <QMutexLocker>
+#include <QtEndian>
+
+#include <cstring>
+
+#define MAX_QUEUED_MBYTES 256
+
+namespace ReconstructMeGUI {
+
+  frame_recorder::frame_recorder(QObject *parent) : 
+    QThread(parent),
+    _queued_bytes(0),
+    _max_queued_bytes(MAX_QUEUED_MBYTES * 1024 * 1024),
+    _recording(false),
+    _stop_requested(false),
+    _lossy_aux(false),
+    _num_frames(0),
+    _num_dropped(0)
+  {
+  }
+
+  frame_recorder::~frame_recorder() {
+    stop_recording();
+  }
+
+  bool frame_recorder::is_recording() const {
+    QMutexLocker lock(&_mutex);
+    return _recording;
+  }
+
+  bool frame_recorder::start_recording(const QString &file_name) {
+    stop_recording();
+
+    _lossy_aux = settings_store::instance().get(record_aux_lossy_tag, record_aux_lossy_default_tag);
+
+    _file.setFileName(file_name);
+    if (!_file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+      return false;
+
+    _file.write(recording::magic, recording::magic_size);
+
+    recording_header header;
+    header.set_version(recording::version);
+    header.set_sensor(settings_store::instance().value(sensor_path_tag, sensor_path_default_tag).toString().toStdString());
+    write_chunk(recording::CHUNK_HEADER, header.SerializeAsString());
+
+    _index.Clear();
+    _num_frames = 0;
+    _num_dropped = 0;
+    _queued_bytes = 0;
+    _pending.reset();
+    _stop_requested = false;
+    _clock.start();
+
+    {
+      QMutexLocker lock(&_mutex);
+      _recording = true;
+    }
+
+    start(QThread::LowPriority);
+    emit recording_started(file_name);
+    return true;
+  }
+
+  void frame_recorder::stop_recording() {
+    {
+      QMutexLocker lock(&_mutex);
+      if (!_recording) 
+        return;
+
+      enqueue_pending();
+      _recording = false;
+      _stop_requested = true;
+      _queue_not_empty.wakeAll();
+    }
+
+    // Writer drains the queue before it terminates
+    wait();
+
+    _index.set_dropped_frames(_num_dropped);
+    const qint64 index_offset = _file.pos();
+    write_chunk(recording::CHUNK_INDEX, _index.SerializeAsString());
+
+    quint64 offset_le = qToLittleEndian<quint64>(index_offset);
+    _file.write(reinterpret_cast<const char*>(&offset_le), sizeof(offset_le));
+    _file.write(recording::trailer_magic, recording::magic_size);
+    _file.close();
+
+    emit recording_stopped(_num_frames, _num_dropped);
+  }
+
+  void frame_recorder::begin_frame() {
+    QMutexLocker lock(&_mutex);
+    if (!_recording)
+      return;
+
+    enqueue_pending();
+
+    _pending = std::shared_ptr<raw_frame>(new raw_frame());
+    _pending->timestamp_us = _clock.nsecsElapsed() / 1000;
+    _pending->track_success = false;
+    _pending->num_bytes = 0;
+  }
+
+  void frame_recorder::add_image(reme_sensor_image_t type, const void *data, int length, int width, int height, int channels, int num_bytes_per_channel, int row_stride) {
+    QMutexLocker lock(&_mutex);
+    if (!_recording || !_pending || data == 0)
+      return;
+
+    recording::image img;
+    img.type = type;
+    img.width = width;
+    img.height = height;
+    img.channels = channels;
+    img.num_bytes_per_channel = num_bytes_per_channel;
+    img.row_stride = row_stride;
+    img.data = QByteArray(static_cast<const char*>(data), length);
+
+    _pending->images.push_back(img);
+    _pending->num_bytes += length;
+  }
+
+  void frame_recorder::add_pose(const float *pose, bool track_success) {
+    QMutexLocker lock(&_mutex);
+    if (!_recording || !_pending)
+      return;
+
+    _pending->pose.resize(16);
+    std::memcpy(_pending->pose.data(), pose, 16 * sizeof(float));
+    _pending->track_success = track_success;
+  }
+
+  void frame_recorder::enqueue_pending() {
+    // Assumes _mutex is held
+    if (!_pending || _pending->images.isEmpty()) 
+      return;
+
+    if (_queued_bytes + _pending->num_bytes > _max_queued_bytes) {
+      _num_dropped++;
+    } else {
+      _queued_bytes += _pending->num_bytes;
+      _queue.enqueue(_pending);
+      _queue_not_empty.wakeOne();
+    }
+    _pending.reset();
+  }
+
+  void frame_recorder::run() {
+    forever {
+      std::shared_ptr<raw_frame> f;
+      {
+        QMutexLocker lock(&_mutex);
+        while (_queue.isEmpty() && !_stop_requested)
+          _queue_not_empty.wait(&_mutex);
+
+        if (_queue.isEmpty())
+          break;
+
+        f = _queue.dequeue();
+      }
+      
+      write_frame(*f);
+
+      QMutexLocker lock(&_mutex);
+      _queued_bytes -= f->num_bytes;
+    }
+  }
+
+  void frame_recorder::write_frame(const raw_frame &f) {
+    recorded_frame msg;
+    msg.set_timestamp_us(f.timestamp_us);
+    
+    for (int i = 0; i < f.images.size(); ++i) {
+      const recording::image &img = f.images[i];
+      recording::encode_image(
+        img.type, img.data.constData(), img.data.size(),
+        img.width, img.height, img.channels, img.num_bytes_per_channel, img.row_stride,
+        _lossy_aux && img.type == REME_IMAGE_AUX, *msg.add_images());
+    }
+
+    if (f.pose.size() == 16) {
+      for (int i = 0; i < 16; ++i)
+        msg.add_pose(f.pose[i]);
+      msg.set_track_success(f.track_success);
+    }
+
+    recording_index_entry *e = _index.add_frames();
+    e->set_timestamp_us(f.timestamp_us);
+    e->set_offset(_file.pos());
+
+    write_chunk(recording::CHUNK_FRAME, msg.SerializeAsString());
+    _num_frames++;
+  }
+
+  void frame_recorder::write_chunk(recording::chunk_t type, const std::string &payload) {
+    quint32 header[2];
+    header[0] = qToLittleEndian<quint32>(type);
+    header[1] = qToLittleEndian<quint32>((quint32)payload.size());
+    _file.write(reinterpret_cast<const char*>(header), sizeof(header));
+    _file.write(payload.data(), payload.size());
+  }
+}
@@ -0,0 +1,191 @@
+/** @file
+  * @copyright Copyright (c) 2013 PROFACTOR GmbH. All rights reserved. 
+  *
+  * Redistribution and use in source and binary forms, with or without
+  * modification, are permitted provided that the following conditions are
+  * met:
+  *
+  *     * Redistributions of source code must retain the above copyright
+  * notice, this list of conditions and the following disclaimer.
+  *     * Redistributions in binary form must reproduce the above
+  * copyright notice, this list of conditions and the following disclaimer
+  * in the documentation and/or other materials provided with the
+  * distribution.
+  *     * Neither the name of Profactor GmbH nor the names of its
+  * contributors may be used to endorse or promote products derived from
+  * this software without specific prior written permission.
+  *
+  * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  *
+  * @authors christoph.kopf@profactor.at
+  *          florian.eckerstorfer@profactor.at
+  */
+
+#include "kernel_cache.h"
+#include "settings_store.h"
+
+#include <QSettings>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QFileInfo>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QCryptographicHash>
+#include <QSet>
+
+namespace ReconstructMeGUI {
+
+  static const char *manifest_name = "manifest.ini";
+
+  /** Batch workers of one process share the manifest */
+  static QMutex manifest_mutex;
+
+  /** Size and SHA-1 of a cached binary, empty if it cannot be read */
+  static QString digest(const QString &path) {
+    QFile f(path);
+    if (!f.open(QIODevice::ReadOnly))
+      return QString();
+    QCryptographicHash h(QCryptographicHash::Sha1);
+    h.addData(f.readAll());
+    return QString("%1:%2").arg(f.size()).arg(QString(h.result().toHex()));
+  }
+
+  kernel_cache::kernel_cache(const QString &root) : _root(root)
+  {}
+
+  QString kernel_cache::default_root() {
+    return settings_store::instance().directory() + "/kernel_cache";
+  }
+
+  QString kernel_cache::make_key(int device_id, const QString &device_name, const QString &driver_version, const QString &sdk_version, const QByteArray &options) {
+    QCryptographicHash h(QCryptographicHash::Sha1);
+    h.addData(QByteArray::number(device_id));
+    h.addData(device_name.toUtf8());
+    h.addData(driver_version.toUtf8());
+    h.addData(sdk_version.toUtf8());
+    h.addData(options);
+    return h.result().toHex();
+  }
+
+  const QString &kernel_cache::root() const {
+    return _root;
+  }
+
+  void kernel_cache::export_environment() const {
+    QDir().mkpath(_root);
+
+    // NVIDIA
+    if (qgetenv("CUDA_CACHE_PATH").isEmpty()) {
+      qputenv("CUDA_CACHE_PATH", QDir::toNativeSeparators(_root + "/nv").toLocal8Bit());
+      qputenv("CUDA_CACHE_MAXSIZE", "268435456");
+    }
+    // Intel
+    if (qgetenv("cl_cache_dir").isEmpty()) {
+      QDir().mkpath(_root + "/intel");
+      qputenv("cl_cache_dir", QDir::toNativeSeparators(_root + "/intel").toLocal8Bit());
+    }
+  }
+
+  bool kernel_cache::validate(const QString &sdk_version) {
+    QMutexLocker lock(&manifest_mutex);
+    QSettings manifest(manifest_path(), QSettings::IniFormat);
+    if (manifest.value("sdk_version").toString() == sdk_version)
+      return true;
+
+    clear();
+    QSettings fresh(manifest_path(), QSettings::IniFormat);
+    fresh.setValue("sdk_version", sdk_version);
+    return false;
+  }
+
+  QStringList kernel_cache::files() const {
+    QStringList result;
+    QDir root(_root);
+    QDirIterator it(_root, QDir::Files, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+      const QString path = root.relativeFilePath(it.next());
+      if (path != manifest_name)
+        result.push_back(path);
+    }
+    return result;
+  }
+
+  bool kernel_cache::contains(const QString &key) {
+    QMutexLocker lock(&manifest_mutex);
+    QSettings manifest(manifest_path(), QSettings::IniFormat);
+    const QString group = "entries/" + key;
+    if (!manifest.contains(group + "/msecs"))
+      return false;
+
+    // Each entry lists "size:sha1:path" of the binaries its compilation added
+    const QStringList entries = manifest.value(group + "/files").toStringList();
+    bool intact = !entries.isEmpty();
+    foreach(const QString &e, entries) {
+      if (digest(_root + "/" + e.section(':', 2)) != e.section(':', 0, 1)) {
+        intact = false;
+        break;
+      }
+    }
+    if (intact)
+      return true;
+
+    // Stale binaries are removed so the runtime writes fresh ones
+    foreach(const QString &e, entries)
+      QFile::remove(_root + "/" + e.section(':', 2));
+    manifest.remove(group);
+    return false;
+  }
+
+  void kernel_cache::insert(const QString &key, int compile_msecs, const QStringList &before) {
+    QMutexLocker lock(&manifest_mutex);
+    QSettings manifest(manifest_path(), QSettings::IniFormat);
+    const QString group = "entries/" + key;
+    if (manifest.contains(group + "/msecs"))
+      return;
+
+    // Only binaries written by this compilation belong to the entry
+    QStringList entries;
+    const QSet<QString> known = before.toSet();
+    foreach(const QString &path, files()) {
+      if (known.contains(path))
+        continue;
+      const QString d = digest(_root + "/" + path);
+      if (!d.isEmpty())
+        entries.push_back(d + ":" + path);
+    }
+
+    // Nothing to verify a later hit against, the runtime did not cache this compilation
+    if (entries.isEmpty())
+      return;
+
+    manifest.setValue(group + "/msecs", compile_msecs);
+    manifest.setValue(group + "/files", entries);
+  }
+
+  int kernel_cache::cold_msecs(const QString &key) const {
+    QMutexLocker lock(&manifest_mutex);
+    QSettings manifest(manifest_path(), QSettings::IniFormat);
+    return manifest.value("entries/" + key + "/msecs", -1).toInt();
+  }
+
+  QString kernel_cache::manifest_path() const {
+    return _root + "/" + manifest_name;
+  }
+
+  void kernel_cache::clear() {
+    QDirIterator it(_root, QDir::Files, QDirIterator::Subdirectories);
+    while (it.hasNext())
+      QFile::remove(it.next());
+  }
+}
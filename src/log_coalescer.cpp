@@ -0,0 +1,169 @@
+/** @file
+  * @copyright Copyright (c) 2013 PROFACTOR GmbH. All rights reserved. 
+  *
+  * Redistribution and use in source and binary forms, with or without
+  * modification, are permitted provided that the following conditions are
+  * met:
+  *
+  *     * Redistributions of source code must retain the above copyright
+  * notice, this list of conditions and the following disclaimer.
+  *     * Redistributions in binary form must reproduce the above
+  * copyright notice, this list of conditions and the following disclaimer
+  * in the documentation and/or other materials provided with the
+  * distribution.
+  *     * Neither the name of Profactor GmbH nor the names of its
+  * contributors may be used to endorse or promote products derived from
+  * this software without specific prior written permission.
+  *
+  * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  *
+  * @authors christoph.kopf@profactor.at
+  *          florian.eckerstorfer@profactor.at
+  */
+
+#include "log_coalescer.h"
+
+#include <algorithm>
+
+namespace ReconstructMeGUI {
+
+  log_coalescer::log_coalescer() :
+    _has_run(false),
+    _run_passed(false),
+    _run_sev(REME_LOG_SEVERITY_INFO),
+    _run_repeats(0),
+    _run_first_us(0),
+    _run_last_us(0)
+  {
+    set_limit(REME_LOG_SEVERITY_INFO, 20, 50);
+    set_limit(REME_LOG_SEVERITY_WARNING, 20, 50);
+    set_limit(REME_LOG_SEVERITY_ERROR, 50, 100);
+  }
+
+  int log_coalescer::bucket_index(reme_log_severity_t sev) {
+    switch (sev) {
+      case REME_LOG_SEVERITY_INFO:
+        return 0;
+      case REME_LOG_SEVERITY_WARNING:
+        return 1;
+      default:
+        return 2;
+    }
+  }
+
+  void log_coalescer::set_limit(reme_log_severity_t sev, double rate_per_sec, int burst) {
+    bucket &b = _buckets[bucket_index(sev)];
+    b.rate_per_us = rate_per_sec / 1e6;
+    b.burst = std::max(1, burst);
+    b.tokens = b.burst;
+    b.last_us = 0;
+    b.suppressed = 0;
+    b.first_suppressed_us = b.last_suppressed_us = 0;
+  }
+
+  bool log_coalescer::take(bucket &b, qint64 now_us) {
+    if (now_us > b.last_us) {
+      b.tokens = std::min(b.burst, b.tokens + (now_us - b.last_us) * b.rate_per_us);
+      b.last_us = now_us;
+    }
+    if (b.tokens < 1)
+      return false;
+    b.tokens -= 1;
+    return true;
+  }
+
+  void log_coalescer::suppress(bucket &b, qint64 now_us) {
+    if (b.suppressed++ == 0)
+      b.first_suppressed_us = now_us;
+    b.last_suppressed_us = now_us;
+  }
+
+  void log_coalescer::end_run(QVector<log_record> &out) {
+    if (_has_run && _run_passed && _run_repeats > 0) {
+      log_record r;
+      r.sev = _run_sev;
+      r.message = _run_message;
+      r.count = _run_repeats;
+      r.first_us = _run_first_us;
+      r.last_us = _run_last_us;
+      out.push_back(r);
+    }
+    _run_repeats = 0;
+  }
+
+  void log_coalescer::report_suppressed(reme_log_severity_t sev, bucket &b, QVector<log_record> &out) {
+    if (b.suppressed == 0)
+      return;
+
+    log_record r;
+    r.sev = sev;
+    r.message = QString("%1 messages suppressed by the log rate limit").arg(b.suppressed);
+    r.count = 1;
+    r.first_us = b.first_suppressed_us;
+    r.last_us = b.last_suppressed_us;
+    out.push_back(r);
+    b.suppressed = 0;
+  }
+
+  void log_coalescer::add(reme_log_severity_t sev, const QString &message, qint64 now_us, QVector<log_record> &out) {
+    bucket &b = _buckets[bucket_index(sev)];
+
+    if (_has_run && sev == _run_sev && message == _run_message) {
+      if (!_run_passed) {
+        suppress(b, now_us);
+        return;
+      }
+      if (_run_repeats++ == 0)
+        _run_first_us = now_us;
+      _run_last_us = now_us;
+      return;
+    }
+
+    end_run(out);
+
+    _has_run = true;
+    _run_sev = sev;
+    _run_message = message;
+    _run_passed = take(b, now_us);
+
+    if (!_run_passed) {
+      suppress(b, now_us);
+      return;
+    }
+
+    report_suppressed(sev, b, out);
+
+    log_record r;
+    r.sev = sev;
+    r.message = message;
+    r.count = 1;
+    r.first_us = r.last_us = now_us;
+    out.push_back(r);
+  }
+
+  void log_coalescer::flush(qint64 now_us, QVector<log_record> &out) {
+    end_run(out);
+
+    static const reme_log_severity_t sevs[3] = {
+      REME_LOG_SEVERITY_INFO, REME_LOG_SEVERITY_WARNING, REME_LOG_SEVERITY_ERROR
+    };
+    for (int i = 0; i < 3; ++i) {
+      // Notices do not take tokens, but wait until the bucket refills
+      bucket &b = _buckets[i];
+      if (b.suppressed > 0 && take(b, now_us)) {
+        b.tokens += 1;
+        report_suppressed(sevs[i], b, out);
+      }
+    }
+  }
+}
@@ -0,0 +1,301 @@
+/** @file
+  * @copyright Copyright (c) 2013 PROFACTOR GmbH. All rights reserved. 
+  *
+  * Redistribution and use in source and binary forms, with or without
+  * modification, are permitted provided that the following conditions are
+  * met:
+  *
+  *     * Redistributions of source code must retain the above copyright
+  * notice, this list of conditions and the following disclaimer.
+  *     * Redistributions in binary form must reproduce the above
+  * copyright notice, this list of conditions and the following disclaimer
+  * in the documentation and/or other materials provided with the
+  * distribution.
+  *     * Neither the name of Profactor GmbH nor the names of its
+  * contributors may be used to endorse or promote products derived from
+  * this software without specific prior written permission.
+  *
+  * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  *
+  * @authors christoph.kopf@profactor.at
+  *          florian.eckerstorfer@profactor.at
+  */
+
+#include "log_file_model.h"
+#include "log_model.h"
+
+#include <QtConcurrentRun>
+#include <QMutexLocker>
+#include <QApplication>
+#include <QStyle>
+#include <QDateTime>
+
+namespace ReconstructMeGUI {
+
+  namespace {
+    /** Records handed over from the indexer at once */
+    const int index_batch = 65536;
+
+    bool read_varint(const uchar *&p, const uchar *end, quint64 &v) {
+      v = 0;
+      for (int shift = 0; shift < 64 && p < end; shift += 7) {
+        const uchar b = *p++;
+        v |= (quint64)(b & 0x7f) << shift;
+        if (!(b & 0x80))
+          return true;
+      }
+      return false;
+    }
+
+    /** Skips a field of wire_type, returns false if the data ends within */
+    bool skip_field(int wire_type, const uchar *&p, const uchar *end) {
+      quint64 v;
+      switch (wire_type) {
+        case 0:
+          return read_varint(p, end, v);
+        case 1:
+          p += 8;
+          return p <= end;
+        case 2:
+          if (!read_varint(p, end, v) || v > (quint64)(end - p))
+            return false;
+          p += v;
+          return true;
+        case 5:
+          p += 4;
+          return p <= end;
+        default:
+          return false;
+      }
+    }
+  }
+
+  log_file_model::log_file_model(QObject *parent) : 
+    QAbstractTableModel(parent),
+    _data(0),
+    _size(0),
+    _cancel(0),
+    _done(1),
+    _decoded(2000)
+  {
+    _publish_timer.setInterval(100);
+    connect(&_publish_timer, SIGNAL(timeout()), SLOT(publish()));
+  }
+
+  log_file_model::~log_file_model() {
+    close();
+  }
+
+  bool log_file_model::open(const QString &path) {
+    close();
+
+    _file.setFileName(path);
+    if (!_file.open(QIODevice::ReadOnly))
+      return false;
+
+    _size = _file.size();
+    _data = _size > 0 ? _file.map(0, _size) : 0;
+    if (_size > 0 && _data == 0) {
+      _file.close();
+      return false;
+    }
+
+    _cancel = 0;
+    _done = 0;
+    _indexer = QtConcurrent::run(this, &log_file_model::index_records);
+    _publish_timer.start();
+    return true;
+  }
+
+  void log_file_model::close() {
+    _cancel = 1;
+    _indexer.waitForFinished();
+    _publish_timer.stop();
+
+    beginResetModel();
+    _records.clear();
+    _found.clear();
+    _decoded.clear();
+    if (_data != 0)
+      _file.unmap(const_cast<uchar*>(_data));
+    _data = 0;
+    _size = 0;
+    _file.close();
+    endResetModel();
+  }
+
+  QString log_file_model::path() const {
+    return _file.fileName();
+  }
+
+  bool log_file_model::indexing() const {
+    return _done == 0;
+  }
+
+  void log_file_model::index_records() {
+    const uchar *p = _data;
+    const uchar *end = _data + _size;
+
+    QVector<record> batch;
+    batch.reserve(index_batch);
+
+    while (p < end && _cancel == 0) {
+      quint64 key, len;
+      if (!read_varint(p, end, key))
+        break;
+
+      const int field = (int)(key >> 3);
+      const int wire_type = (int)(key & 7);
+
+      if (field != 1 || wire_type != 2) {
+        if (!skip_field(wire_type, p, end))
+          break;
+        continue;
+      }
+
+      if (!read_varint(p, end, len) || len > (quint64)(end - p))
+        break;
+
+      record r;
+      r.offset = p - _data;
+      r.size = (int)len;
+      batch.push_back(r);
+      p += len;
+
+      if (batch.size() == index_batch) {
+        QMutexLocker lock(&_mutex);
+        _found += batch;
+        batch.clear();
+      }
+    }
+
+    QMutexLocker lock(&_mutex);
+    _found += batch;
+    _done = 1;
+  }
+
+  void log_file_model::publish() {
+    const bool done = (_done != 0);
+    
+    QVector<record> found;
+    {
+      QMutexLocker lock(&_mutex);
+      found.swap(_found);
+    }
+
+    if (!found.isEmpty()) {
+      beginInsertRows(QModelIndex(), _records.size(), _records.size() + found.size() - 1);
+      _records += found;
+      endInsertRows();
+    }
+
+    if (done) {
+      _publish_timer.stop();
+      emit indexed(_records.size());
+    }
+  }
+
+  const logging_info_log_entry *log_file_model::decode(int row) const {
+    logging_info_log_entry *e = _decoded.object(row);
+    if (e != 0)
+      return e;
+
+    const record &r = _records[row];
+    e = new logging_info_log_entry();
+    if (!e->ParsePartialFromArray(_data + r.offset, r.size)) {
+      delete e;
+      return 0;
+    }
+    _decoded.insert(row, e);
+    return e;
+  }
+
+  int log_file_model::rowCount(const QModelIndex &parent) const {
+    return parent.isValid() ? 0 : _records.size();
+  }
+
+  int log_file_model::columnCount(const QModelIndex &parent) const {
+    return parent.isValid() ? 0 : log_model::NUM_COLUMNS;
+  }
+
+  QVariant log_file_model::data(const QModelIndex &index, int role) const {
+    if (!index.isValid() || index.row() >= _records.size())
+      return QVariant();
+
+    const logging_info_log_entry *e = decode(index.row());
+    if (e == 0)
+      return role == Qt::DisplayRole && index.column() == log_model::MESSAGE_COLUMN ? 
+        QVariant(tr("<corrupt record>")) : QVariant();
+
+    reme_log_severity_t sev;
+    switch (e->sev()) {
+      case logging_info::INFO:
+        sev = REME_LOG_SEVERITY_INFO;
+        break;
+      case logging_info::WARNING:
+        sev = REME_LOG_SEVERITY_WARNING;
+        break;
+      default:
+        sev = REME_LOG_SEVERITY_ERROR;
+        break;
+    }
+
+    if (role == Qt::DisplayRole) {
+      switch (index.column()) {
+        case log_model::SEVERITY_COLUMN:
+          return log_model::severity_text(sev);
+        case log_model::TIMESTAMP_COLUMN:
+          return QString::fromUtf8(e->date().c_str());
+        case log_model::MESSAGE_COLUMN: {
+          const QString message = QString::fromUtf8(e->log().c_str());
+          if (e->repeat_count() > 1)
+            return tr("%1 (repeated %2 times until %3)")
+              .arg(message).arg(e->repeat_count())
+              .arg(QDateTime::fromMSecsSinceEpoch(e->last_time_msecs()).time().toString());
+          return message;
+        }
+      }
+    } else if (role == Qt::DecorationRole && index.column() == log_model::SEVERITY_COLUMN) {
+      int i;
+      QStyle::StandardPixmap pixmap;
+      switch (sev) {
+        case REME_LOG_SEVERITY_INFO:
+          i = 0; pixmap = QStyle::SP_MessageBoxInformation; break;
+        case REME_LOG_SEVERITY_WARNING:
+          i = 1; pixmap = QStyle::SP_MessageBoxWarning; break;
+        default:
+          i = 2; pixmap = QStyle::SP_MessageBoxCritical; break;
+      }
+      if (_icons[i].isNull())
+        _icons[i] = QApplication::style()->standardIcon(pixmap);
+      return _icons[i];
+    }
+
+    return QVariant();
+  }
+
+  QVariant log_file_model::headerData(int section, Qt::Orientation orientation, int role) const {
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole)
+      return QAbstractTableModel::headerData(section, orientation, role);
+
+    switch (section) {
+      case log_model::SEVERITY_COLUMN:
+        return tr("Severity");
+      case log_model::TIMESTAMP_COLUMN:
+        return tr("Timestamp");
+      case log_model::MESSAGE_COLUMN:
+        return tr("Message");
+    }
+    return QVariant();
+  }
+}
@@ -0,0 +1,246 @@
+/** @file
+  * @copyright Copyright (c) 2013 PROFACTOR GmbH. All rights reserved. 
+  *
+  * Redistribution and use in source and binary forms, with or without
+  * modification, are permitted provided that the following conditions are
+  * met:
+  *
+  *     * Redistributions of source code must retain the above copyright
+  * notice, this list of conditions and the following disclaimer.
+  *     * Redistributions in binary form must reproduce the above
+  * copyright notice, this list of conditions and the following disclaimer
+  * in the documentation and/or other materials provided with the
+  * distribution.
+  *     * Neither the name of Profactor GmbH nor the names of its
+  * contributors may be used to endorse or promote products derived from
+  * this software without specific prior written permission.
+  *
+  * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  *
+  * @authors christoph.kopf@profactor.at
+  *          florian.eckerstorfer@profactor.at
+  */
+
+#include "log_index.h"
+
+#include <QSet>
+
+#include <algorithm>
+#include <limits>
+
+namespace ReconstructMeGUI {
+
+  namespace {
+    /** Intersection of two ascending sequence lists */
+    QVector<qint64> intersect(const QVector<qint64> &a, const QVector<qint64> &b) {
+      QVector<qint64> r;
+      r.reserve(std::min(a.size(), b.size()));
+      std::set_intersection(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(r));
+      return r;
+    }
+
+    /** Removes elements before seq from an ascending sequence list */
+    void drop_front(QVector<qint64> &v, qint64 seq) {
+      QVector<qint64>::iterator i = std::lower_bound(v.begin(), v.end(), seq);
+      v.erase(v.begin(), i);
+    }
+  }
+
+  log_index::query::query() : 
+    severities(ALL_MASK), 
+    from_msecs(std::numeric_limits<qint64>::min()),
+    to_msecs(std::numeric_limits<qint64>::max())
+  {}
+
+  bool log_index::query::is_empty() const {
+    return severities == ALL_MASK && 
+      from_msecs == std::numeric_limits<qint64>::min() &&
+      to_msecs == std::numeric_limits<qint64>::max() &&
+      text.isEmpty();
+  }
+
+  log_index::log_index() : 
+    _base_seq(0), 
+    _first_seq(0), 
+    _end_seq(0)
+  {}
+
+  int log_index::severity_mask(reme_log_severity_t sev) {
+    switch (sev) {
+      case REME_LOG_SEVERITY_INFO:
+        return INFO_MASK;
+      case REME_LOG_SEVERITY_WARNING:
+        return WARNING_MASK;
+      default:
+        return ERROR_MASK;
+    }
+  }
+
+  QStringList log_index::tokenize(const QString &text) {
+    QStringList tokens;
+    const int n = text.size();
+    int start = -1;
+    for (int i = 0; i <= n; ++i) {
+      const bool word = i < n && text[i].isLetterOrNumber();
+      if (word && start < 0) {
+        start = i;
+      } else if (!word && start >= 0) {
+        tokens << text.mid(start, i - start).toLower();
+        start = -1;
+      }
+    }
+    return tokens;
+  }
+
+  void log_index::add(reme_log_severity_t sev, qint64 msecs, const QString &message) {
+    const qint64 seq = _end_seq++;
+    const int mask = severity_mask(sev);
+
+    // Keep timestamps ascending, collapsed runs are reported after later messages
+    _msecs.push_back(_msecs.isEmpty() ? msecs : std::max(msecs, _msecs.back()));
+    _sev.push_back((char)mask);
+    _by_severity[mask == INFO_MASK ? 0 : (mask == WARNING_MASK ? 1 : 2)].push_back(seq);
+
+    QStringList tokens = tokenize(message);
+    for (int i = 0; i < tokens.size(); ++i) {
+      QVector<qint64> &p = _postings[tokens[i]];
+      if (p.isEmpty() || p.back() != seq)
+        p.push_back(seq);
+    }
+  }
+
+  void log_index::drop_before(qint64 seq) {
+    _first_seq = std::min(std::max(_first_seq, seq), _end_seq);
+
+    // Compact once more than half of the stored entries are dropped
+    if (_first_seq - _base_seq > _end_seq - _first_seq)
+      compact();
+  }
+
+  void log_index::compact() {
+    const int dropped = pos(_first_seq);
+    _msecs.remove(0, dropped);
+    _sev.remove(0, dropped);
+    _base_seq = _first_seq;
+
+    for (int i = 0; i < 3; ++i)
+      drop_front(_by_severity[i], _first_seq);
+
+    QHash<QString, QVector<qint64> >::iterator i = _postings.begin();
+    while (i != _postings.end()) {
+      drop_front(i.value(), _first_seq);
+      if (i.value().isEmpty())
+        i = _postings.erase(i);
+      else
+        ++i;
+    }
+  }
+
+  void log_index::clear() {
+    _msecs.clear();
+    _sev.clear();
+    for (int i = 0; i < 3; ++i)
+      _by_severity[i].clear();
+    _postings.clear();
+    _base_seq = _first_seq = _end_seq;
+  }
+
+  qint64 log_index::first_seq() const {
+    return _first_seq;
+  }
+
+  qint64 log_index::end_seq() const {
+    return _end_seq;
+  }
+
+  bool log_index::matches(const query &q, qint64 seq, const source &src) const {
+    if (seq < _first_seq || seq >= _end_seq)
+      return false;
+    const int p = pos(seq);
+    if (!(_sev[p] & q.severities))
+      return false;
+    if (_msecs[p] < q.from_msecs || _msecs[p] > q.to_msecs)
+      return false;
+    return q.text.isEmpty() || src.message(seq).contains(q.text, Qt::CaseInsensitive);
+  }
+
+  QVector<qint64> log_index::search(const query &q, const source &src) const {
+    // Time range to sequence range, timestamps are ascending
+    const int first = pos(_first_seq);
+    const qint64 lo = _base_seq + (std::lower_bound(_msecs.begin() + first, _msecs.end(), q.from_msecs) - _msecs.begin());
+    const qint64 hi = _base_seq + (std::upper_bound(_msecs.begin() + first, _msecs.end(), q.to_msecs) - _msecs.begin());
+
+    QVector<qint64> candidates;
+    bool have_candidates = false;
+
+    // Entries holding every query word as part of one of their tokens
+    const QStringList words = tokenize(q.text);
+    for (int w = 0; w < words.size(); ++w) {
+      QSet<qint64> hits;
+      QHash<QString, QVector<qint64> >::const_iterator i;
+      for (i = _postings.constBegin(); i != _postings.constEnd(); ++i) {
+        if (!i.key().contains(words[w]))
+          continue;
+        const QVector<qint64> &p = i.value();
+        QVector<qint64>::const_iterator b = std::lower_bound(p.begin(), p.end(), lo);
+        QVector<qint64>::const_iterator e = std::lower_bound(b, p.end(), hi);
+        for (; b != e; ++b)
+          hits.insert(*b);
+      }
+
+      QVector<qint64> sorted;
+      sorted.reserve(hits.size());
+      foreach (qint64 s, hits)
+        sorted.push_back(s);
+      std::sort(sorted.begin(), sorted.end());
+
+      candidates = have_candidates ? intersect(candidates, sorted) : sorted;
+      have_candidates = true;
+      if (candidates.isEmpty())
+        return candidates;
+    }
+
+    if (!have_candidates) {
+      if (q.severities == ALL_MASK) {
+        candidates.reserve((int)(hi - lo));
+        for (qint64 s = lo; s < hi; ++s)
+          candidates.push_back(s);
+      } else {
+        for (int i = 0; i < 3; ++i) {
+          if (!(q.severities & (1 << i)))
+            continue;
+          const QVector<qint64> &p = _by_severity[i];
+          QVector<qint64>::const_iterator b = std::lower_bound(p.begin(), p.end(), lo);
+          QVector<qint64>::const_iterator e = std::lower_bound(b, p.end(), hi);
+          QVector<qint64> merged;
+          std::merge(candidates.begin(), candidates.end(), b, e, std::back_inserter(merged));
+          candidates.swap(merged);
+        }
+      }
+      if (q.text.isEmpty())
+        return candidates;
+    }
+
+    QVector<qint64> result;
+    result.reserve(candidates.size());
+    for (int i = 0; i < candidates.size(); ++i) {
+      const qint64 s = candidates[i];
+      if (!(_sev[pos(s)] & q.severities))
+        continue;
+      if (!q.text.isEmpty() && !src.message(s).contains(q.text, Qt::CaseInsensitive))
+        continue;
+      result.push_back(s);
+    }
+    return result;
+  }
+}
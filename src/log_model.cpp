@@ -0,0 +1,449 @@
+/** @file
+  * @copyright Copyright (c) 2013 PROFACTOR GmbH. All rights reserved. 
+  *
+  * Redistribution and use in source and binary forms, with or without
+  * modification, are permitted provided that the following conditions are
+  * met:
+  *
+  *     * Redistributions of source code must retain the above copyright
+  * notice, this list of conditions and the following disclaimer.
+  *     * Redistributions in binary form must reproduce the above
+  * copyright notice, this list of conditions and the following disclaimer
+  * in the documentation and/or other materials provided with the
+  * distribution.
+  *     * Neither the name of Profactor GmbH nor the names of its
+  * contributors may be used to endorse or promote products derived from
+  * this software without specific prior written permission.
+  *
+  * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  *
+  * @authors christoph.kopf@profactor.at
+  *          florian.eckerstorfer@profactor.at
+  */
+
+#include "log_model.h"
+
+#include <QApplication>
+#include <QStyle>
+#include <QDateTime>
+
+#include <algorithm>
+
+namespace ReconstructMeGUI {
+
+  namespace {
+    /** Rows handed to the view per fetch while filtered */
+    const int page_size = 1000;
+  }
+
+  log_model::log_model(int capacity, qint64 max_bytes, QObject *parent) : 
+    QAbstractTableModel(parent),
+    _head(0),
+    _count(0),
+    _capacity(std::max(1, capacity)),
+    _first_seq(0),
+    _bytes(0),
+    _max_bytes(max_bytes),
+    _descending(false),
+    _sort_column(TIMESTAMP_COLUMN),
+    _sort_order(Qt::AscendingOrder),
+    _mapped(false),
+    _fetched(0)
+  {
+    _flush_timer.setSingleShot(true);
+    _flush_timer.setInterval(100);
+    connect(&_flush_timer, SIGNAL(timeout()), SLOT(flush()));
+  }
+
+  void log_model::append(reme_log_severity_t sev, const QString &message) {
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    append(sev, message, 1, now, now);
+  }
+
+  void log_model::append(reme_log_severity_t sev, const QString &message, int count, qint64 first_msecs, qint64 last_msecs) {
+    entry e;
+    e.sev = sev;
+    e.msecs = first_msecs;
+    e.message = message;
+    e.count = count;
+    e.last_msecs = last_msecs;
+    _pending.push_back(e);
+
+    if (!_flush_timer.isActive())
+      _flush_timer.start();
+  }
+
+  void log_model::set_flush_interval(int msecs) {
+    _flush_timer.setInterval(msecs);
+  }
+
+  void log_model::set_filter(const log_index::query &q) {
+    _filter = q;
+    rebuild_rows();
+  }
+
+  const log_index::query &log_model::filter() const {
+    return _filter;
+  }
+
+  int log_model::num_matches() const {
+    return _mapped ? _rows.size() : _count;
+  }
+
+  int log_model::size() const {
+    return _count;
+  }
+
+  const log_model::entry &log_model::at(int i) const {
+    return _ring[(_head + i) % _capacity];
+  }
+
+  const log_model::entry &log_model::at_seq(qint64 seq) const {
+    return at((int)(seq - _first_seq));
+  }
+
+  QString log_model::message(qint64 seq) const {
+    return at_seq(seq).message;
+  }
+
+  qint64 log_model::seq_of_row(int row) const {
+    if (_mapped)
+      return _rows[row];
+    return _first_seq + (_descending ? _count - 1 - row : row);
+  }
+
+  const log_model::entry &log_model::at_row(int row) const {
+    return at_seq(seq_of_row(row));
+  }
+
+  qint64 log_model::bytes_of(const entry &e) {
+    return sizeof(entry) + e.message.size() * sizeof(QChar);
+  }
+
+  void log_model::push(const entry &e) {
+    if (_ring.size() < _capacity) {
+      _ring.push_back(e);
+    } else {
+      _ring[(_head + _count) % _capacity] = e;
+    }
+    _count++;
+    _bytes += bytes_of(e);
+    _index.add(e.sev, e.msecs, e.message);
+  }
+
+  void log_model::pop() {
+    entry &e = _ring[_head];
+    _bytes -= bytes_of(e);
+    e.message.clear();
+    _head = (_head + 1) % _capacity;
+    _count--;
+    _first_seq++;
+    _index.drop_before(_first_seq);
+  }
+
+  void log_model::flush() {
+    _flush_timer.stop();
+    if (_pending.isEmpty())
+      return;
+
+    // Messages that would be dropped within this batch are never inserted
+    QVector<entry> batch;
+    batch.swap(_pending);
+    if (batch.size() > _capacity)
+      batch.remove(0, batch.size() - _capacity);
+
+    qint64 batch_bytes = 0;
+    for (int i = 0; i < batch.size(); ++i)
+      batch_bytes += bytes_of(batch[i]);
+
+    while (!batch.isEmpty() && batch_bytes > _max_bytes) {
+      batch_bytes -= bytes_of(batch.front());
+      batch.pop_front();
+    }
+
+    const int n = batch.size();
+    
+    int evict = 0;
+    qint64 evict_bytes = 0;
+    while (evict < _count && 
+           (_count - evict + n > _capacity || _bytes - evict_bytes + batch_bytes > _max_bytes)) 
+    {
+      evict_bytes += bytes_of(at(evict));
+      evict++;
+    }
+
+    if (_mapped) {
+      for (int i = 0; i < evict; ++i) 
+        pop();
+      for (int i = 0; i < n; ++i) 
+        push(batch[i]);
+      update_rows(n);
+    } else {
+      if (evict > 0) {
+        if (_descending)
+          beginRemoveRows(QModelIndex(), _count - evict, _count - 1);
+        else
+          beginRemoveRows(QModelIndex(), 0, evict - 1);
+        for (int i = 0; i < evict; ++i) 
+          pop();
+        endRemoveRows();
+      }
+
+      if (n > 0) {
+        if (_descending)
+          beginInsertRows(QModelIndex(), 0, n - 1);
+        else
+          beginInsertRows(QModelIndex(), _count, _count + n - 1);
+        for (int i = 0; i < n; ++i) 
+          push(batch[i]);
+        endInsertRows();
+      }
+    }
+
+    emit flushed();
+  }
+
+  void log_model::update_rows(int n) {
+    // Dropped entries are the oldest, they sit at the front of the rows 
+    // unless sorted descending by time
+    const bool newest_first = (_sort_column == TIMESTAMP_COLUMN && _descending);
+
+    if (newest_first) {
+      int keep = _rows.size();
+      while (keep > 0 && _rows[keep - 1] < _first_seq)
+        keep--;
+      const int visible = std::max(0, _fetched - keep);
+      if (visible > 0) {
+        beginRemoveRows(QModelIndex(), _fetched - visible, _fetched - 1);
+        _rows.resize(keep);
+        _fetched -= visible;
+        endRemoveRows();
+      } else {
+        _rows.resize(keep);
+      }
+    } else if (_sort_column == TIMESTAMP_COLUMN) {
+      const int drop = std::lower_bound(_rows.begin(), _rows.end(), _first_seq) - _rows.begin();
+      const int visible = std::min(drop, _fetched);
+      if (visible > 0)
+        beginRemoveRows(QModelIndex(), 0, visible - 1);
+      _rows.remove(0, drop);
+      _fetched -= visible;
+      if (visible > 0)
+        endRemoveRows();
+    } else {
+      // Sorted by other columns, dropped entries are anywhere
+      beginResetModel();
+      QVector<qint64> rows;
+      rows.reserve(_rows.size());
+      for (int i = 0; i < _rows.size(); ++i)
+        if (_rows[i] >= _first_seq)
+          rows.push_back(_rows[i]);
+      _rows.swap(rows);
+      _fetched = std::min(_fetched, _rows.size());
+      endResetModel();
+    }
+
+    QVector<qint64> added;
+    const qint64 end = _first_seq + _count;
+    for (qint64 s = end - n; s < end; ++s)
+      if (_filter.is_empty() || _index.matches(_filter, s, *this))
+        added.push_back(s);
+
+    if (added.isEmpty())
+      return;
+
+    if (newest_first) {
+      std::reverse(added.begin(), added.end());
+      beginInsertRows(QModelIndex(), 0, added.size() - 1);
+      _rows = added + _rows;
+      _fetched += added.size();
+      endInsertRows();
+    } else if (_fetched == _rows.size()) {
+      beginInsertRows(QModelIndex(), _fetched, _fetched + added.size() - 1);
+      _rows += added;
+      _fetched += added.size();
+      endInsertRows();
+    } else {
+      // Picked up by the view with the next fetch
+      _rows += added;
+    }
+  }
+
+  void log_model::rebuild_rows() {
+    beginResetModel();
+    _mapped = !_filter.is_empty() || _sort_column != TIMESTAMP_COLUMN;
+    _rows.clear();
+    _fetched = 0;
+
+    if (_mapped) {
+      if (_filter.is_empty()) {
+        _rows.reserve(_count);
+        for (int i = 0; i < _count; ++i)
+          _rows.push_back(_first_seq + i);
+      } else {
+        _rows = _index.search(_filter, *this);
+      }
+      order_rows(_rows);
+      _fetched = std::min(page_size, _rows.size());
+    }
+    endResetModel();
+  }
+
+  bool log_model::canFetchMore(const QModelIndex &parent) const {
+    return !parent.isValid() && _mapped && _fetched < _rows.size();
+  }
+
+  void log_model::fetchMore(const QModelIndex &parent) {
+    if (!canFetchMore(parent))
+      return;
+    const int n = std::min(page_size, _rows.size() - _fetched);
+    beginInsertRows(QModelIndex(), _fetched, _fetched + n - 1);
+    _fetched += n;
+    endInsertRows();
+  }
+
+  void log_model::clear() {
+    beginResetModel();
+    _pending.clear();
+    _ring.clear();
+    _head = 0;
+    _first_seq += _count;
+    _count = 0;
+    _bytes = 0;
+    _index.clear();
+    _rows.clear();
+    _fetched = 0;
+    endResetModel();
+  }
+
+  QString log_model::severity_text(reme_log_severity_t sev) {
+    switch (sev) {
+      case REME_LOG_SEVERITY_INFO:
+        return tr("Info");
+      case REME_LOG_SEVERITY_WARNING:
+        return tr("Warning");
+      default:
+        return tr("Error");
+    }
+  }
+
+  int log_model::rowCount(const QModelIndex &parent) const {
+    if (parent.isValid())
+      return 0;
+    return _mapped ? _fetched : _count;
+  }
+
+  int log_model::columnCount(const QModelIndex &parent) const {
+    return parent.isValid() ? 0 : NUM_COLUMNS;
+  }
+
+  QVariant log_model::data(const QModelIndex &index, int role) const {
+    if (!index.isValid() || index.row() >= rowCount())
+      return QVariant();
+
+    const entry &e = at_row(index.row());
+
+    if (role == Qt::DisplayRole) {
+      switch (index.column()) {
+        case SEVERITY_COLUMN:
+          return severity_text(e.sev);
+        case TIMESTAMP_COLUMN:
+          return QDateTime::fromMSecsSinceEpoch(e.msecs).toString();
+        case MESSAGE_COLUMN:
+          if (e.count > 1)
+            return tr("%1 (repeated %2 times until %3)")
+              .arg(e.message).arg(e.count)
+              .arg(QDateTime::fromMSecsSinceEpoch(e.last_msecs).time().toString());
+          return e.message;
+      }
+    } else if (role == Qt::DecorationRole && index.column() == SEVERITY_COLUMN) {
+      int i;
+      QStyle::StandardPixmap pixmap;
+      switch (e.sev) {
+        case REME_LOG_SEVERITY_INFO:
+          i = 0; pixmap = QStyle::SP_MessageBoxInformation; break;
+        case REME_LOG_SEVERITY_WARNING:
+          i = 1; pixmap = QStyle::SP_MessageBoxWarning; break;
+        default:
+          i = 2; pixmap = QStyle::SP_MessageBoxCritical; break;
+      }
+      if (_icons[i].isNull())
+        _icons[i] = QApplication::style()->standardIcon(pixmap);
+      return _icons[i];
+    }
+
+    return QVariant();
+  }
+
+  QVariant log_model::headerData(int section, Qt::Orientation orientation, int role) const {
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole)
+      return QAbstractTableModel::headerData(section, orientation, role);
+
+    switch (section) {
+      case SEVERITY_COLUMN:
+        return tr("Severity");
+      case TIMESTAMP_COLUMN:
+        return tr("Timestamp");
+      case MESSAGE_COLUMN:
+        return tr("Message");
+    }
+    return QVariant();
+  }
+
+  namespace {
+    struct by_severity {
+      const log_model *m;
+      qint64 first;
+      bool operator()(qint64 a, qint64 b) const { 
+        return m->at((int)(a - first)).sev < m->at((int)(b - first)).sev; 
+      }
+    };
+
+    struct by_message {
+      const log_model *m;
+      qint64 first;
+      bool operator()(qint64 a, qint64 b) const { 
+        return m->at((int)(a - first)).message < m->at((int)(b - first)).message; 
+      }
+    };
+  }
+
+  void log_model::order_rows(QVector<qint64> &rows) const {
+    if (_sort_column == SEVERITY_COLUMN) {
+      by_severity cmp = {this, _first_seq};
+      std::stable_sort(rows.begin(), rows.end(), cmp);
+    } else if (_sort_column == MESSAGE_COLUMN) {
+      by_message cmp = {this, _first_seq};
+      std::stable_sort(rows.begin(), rows.end(), cmp);
+    } 
+
+    // Rows are chronological or stably sorted, reversing keeps ties chronological per direction
+    if (_sort_order == Qt::DescendingOrder)
+      std::reverse(rows.begin(), rows.end());
+  }
+
+  void log_model::sort(int column, Qt::SortOrder order) {
+    _sort_column = column;
+    _sort_order = order;
+    _descending = (column == TIMESTAMP_COLUMN && order == Qt::DescendingOrder);
+
+    if (!_mapped && column == TIMESTAMP_COLUMN) {
+      // The ring is chronological already
+      emit layoutAboutToBeChanged();
+      emit layoutChanged();
+      return;
+    }
+
+    rebuild_rows();
+  }
+}
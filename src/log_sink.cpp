@@ -0,0 +1,342 @@
+/** @file
+  * @copyright Copyright (c) 2013 PROFACTOR GmbH. All rights reserved. 
+  *
+  * Redistribution and use in source and binary forms, with or without
+  * modification, are permitted provided that the following conditions are
+  * met:
+  *
+  *     * Redistributions of source code must retain the above copyright
+  * notice, this list of conditions and the following disclaimer.
+  *     * Redistributions in binary form must reproduce the above
+  * copyright notice, this list of conditions and the following disclaimer
+  * in the documentation and/or other materials provided with the
+  * distribution.
+  *     * Neither the name of Profactor GmbH nor the names of its
+  * contributors may be used to endorse or promote products derived from
+  * this software without specific prior written permission.
+  *
+  * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  *
+  * @authors christoph.kopf@profactor.at
+  *          florian.eckerstorfer@profactor.at
+  */
+
+#include "log_sink.h"
+#include "settings_store.h"
+
+#include "log.pb.h"
+
+#include <QCoreApplication>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QDir>
+#include <QRegExp>
+#include <QStringList>
+
+#include <algorithm>
+
+namespace ReconstructMeGUI {
+
+  namespace {
+    const char *log_file_suffix = ".rmlog";
+    /** Number of session logs kept in the log directory */
+    const int kept_sessions = 20;
+    /** Wire tag of logging_info.logs, field 1 and length-delimited */
+    const char logs_tag = (1 << 3) | 2;
+    const int poll_msecs = 20;
+
+    /** Returns false on a truncated or oversized varint */
+    bool read_varint(const char *&p, const char *end, quint64 &v) {
+      v = 0;
+      for (int shift = 0; p < end && shift < 64; shift += 7) {
+        const quint8 b = (quint8)*p++;
+        v |= (quint64)(b & 0x7f) << shift;
+        if ((b & 0x80) == 0)
+          return true;
+      }
+      return false;
+    }
+
+    void append_varint(std::string &buf, quint64 v) {
+      while (v >= 0x80) {
+        buf.push_back((char)(v | 0x80));
+        v >>= 7;
+      }
+      buf.push_back((char)v);
+    }
+
+    /** Unique per process and sink, sinks of one process are numbered */
+    QString session_file_name(const QString &tag) {
+      static QAtomicInt sequence(0);
+      const int seq = sequence.fetchAndAddRelaxed(1);
+
+      QString name = QString("%1_%2_%3")
+        .arg(tag.isEmpty() ? QString("reconstructme") : tag)
+        .arg(QDateTime::currentDateTime().toString("yyyyMMdd-hhmmss"))
+        .arg(QCoreApplication::applicationPid());
+      if (seq > 0)
+        name += QString("-%1").arg(seq);
+      
+      // Keep file names portable, tags may come from job names
+      name.replace(QRegExp("[^A-Za-z0-9_.-]"), "_");
+      return name + log_file_suffix;
+    }
+  }
+
+  log_sink::log_sink(const QString &dir, const QString &tag, qint64 max_file_bytes, int max_files) :
+    _head(&_stub),
+    _tail(&_stub),
+    _dir(dir),
+    _max_file_bytes(max_file_bytes),
+    _max_files(std::max(1, max_files)),
+    _file_bytes(0),
+    _pushed(0),
+    _written(0),
+    _stop(0),
+    _start_msecs(QDateTime::currentMSecsSinceEpoch())
+  {
+    _clock.start();
+    QDir().mkpath(_dir);
+    _file.setFileName(QDir(_dir).absoluteFilePath(session_file_name(tag)));
+  }
+
+  log_sink::~log_sink() {
+    stop();
+
+    node *n;
+    while ((n = dequeue()) != 0)
+      delete n;
+  }
+
+  QString log_sink::default_dir() {
+    return settings_store::instance().directory() + "/logs";
+  }
+
+  QString log_sink::path() const {
+    return _file.fileName();
+  }
+
+  int log_sink::written() const {
+    return _written;
+  }
+
+  qint64 log_sink::now_us() const {
+    return _clock.nsecsElapsed() / 1000;
+  }
+
+  qint64 log_sink::to_msecs(qint64 us) const {
+    return _start_msecs + us / 1000;
+  }
+
+  void log_sink::push(reme_log_severity_t sev, const QString &message) {
+    node *n = new node();
+    n->sev = sev;
+    n->timestamp_us = n->last_us = now_us();
+    n->count = 1;
+    n->message = message;
+    enqueue(n);
+  }
+
+  void log_sink::push(const log_record &r) {
+    node *n = new node();
+    n->sev = r.sev;
+    n->timestamp_us = r.first_us;
+    n->last_us = r.last_us;
+    n->count = r.count;
+    n->message = r.message;
+    enqueue(n);
+  }
+
+  void log_sink::stop() {
+    _stop.fetchAndStoreOrdered(1);
+    if (isRunning())
+      wait();
+  }
+
+  void log_sink::sync() {
+    while (isRunning() && _written.fetchAndAddAcquire(0) < _pushed.fetchAndAddAcquire(0))
+      msleep(1);
+  }
+
+  void log_sink::enqueue(node *n) {
+    // dequeue re-links the stub, only count real messages
+    if (n != &_stub)
+      _pushed.fetchAndAddRelaxed(1);
+    n->next = 0;
+    node *prev = _head.fetchAndStoreOrdered(n);
+    prev->next.fetchAndStoreRelease(n);
+  }
+
+  log_sink::node *log_sink::dequeue() {
+    node *tail = _tail;
+    node *next = tail->next.fetchAndAddAcquire(0);
+
+    if (tail == &_stub) {
+      if (next == 0)
+        return 0;
+      _tail = next;
+      tail = next;
+      next = tail->next.fetchAndAddAcquire(0);
+    }
+
+    if (next != 0) {
+      _tail = next;
+      return tail;
+    }
+
+    // A producer exchanged the head but has not linked its node yet
+    if (tail != _head.fetchAndAddAcquire(0))
+      return 0;
+
+    enqueue(&_stub);
+    next = tail->next.fetchAndAddAcquire(0);
+    if (next != 0) {
+      _tail = next;
+      return tail;
+    }
+    return 0;
+  }
+
+  void log_sink::run() {
+    prune();
+    _file.open(QIODevice::WriteOnly | QIODevice::Truncate);
+
+    while (_stop == 0) {
+      if (!drain())
+        msleep(poll_msecs);
+    }
+    drain();
+    _file.close();
+  }
+
+  bool log_sink::drain() {
+    node *n = dequeue();
+    if (n == 0)
+      return false;
+
+    logging_info_log_entry entry;
+    std::string payload, record;
+
+    while (n != 0) {
+      logging_info::severity sev;
+      switch (n->sev) {
+        case REME_LOG_SEVERITY_INFO:
+          sev = logging_info::INFO;
+          break;
+        case REME_LOG_SEVERITY_WARNING:
+          sev = logging_info::WARNING;
+          break;
+        default:
+          sev = logging_info::ERROR;
+          break;
+      }
+
+      const qint64 msecs = to_msecs(n->timestamp_us);
+      entry.Clear();
+      entry.set_sev(sev);
+      entry.set_date(QDateTime::fromMSecsSinceEpoch(msecs).toString().toStdString());
+      entry.set_log(n->message.toUtf8().constData());
+      entry.set_timestamp_us(n->timestamp_us);
+      entry.set_time_msecs(msecs);
+      if (n->count > 1) {
+        entry.set_repeat_count(n->count);
+        entry.set_last_time_msecs(to_msecs(n->last_us));
+      }
+      delete n;
+
+      payload.clear();
+      entry.SerializeToString(&payload);
+      record.clear();
+      record.push_back(logs_tag);
+      append_varint(record, payload.size());
+      record.append(payload);
+
+      if (_file.isOpen()) {
+        _file.write(record.data(), record.size());
+        _file_bytes += record.size();
+      }
+      _written.fetchAndAddRelaxed(1);
+
+      if (_file_bytes >= _max_file_bytes)
+        rotate();
+
+      n = dequeue();
+    }
+
+    _file.flush();
+    return true;
+  }
+
+  void log_sink::rotate() {
+    _file.close();
+
+    const QString base = _file.fileName();
+    QFile::remove(QString("%1.%2").arg(base).arg(_max_files - 1));
+    for (int i = _max_files - 2; i >= 1; --i)
+      QFile::rename(QString("%1.%2").arg(base).arg(i), QString("%1.%2").arg(base).arg(i + 1));
+    if (_max_files > 1)
+      QFile::rename(base, base + ".1");
+
+    _file.open(QIODevice::WriteOnly | QIODevice::Truncate);
+    _file_bytes = 0;
+  }
+
+  void log_sink::prune() {
+    QDir dir(_dir);
+    const QFileInfoList logs = dir.entryInfoList(QStringList() << QString("*%1").arg(log_file_suffix), QDir::Files, QDir::Time);
+    const QString own = QFileInfo(_file.fileName()).fileName();
+
+    int kept = 0;
+    foreach(const QFileInfo &fi, logs) {
+      if (fi.fileName() == own || ++kept < kept_sessions)
+        continue;
+
+      QFile::remove(fi.absoluteFilePath());
+      foreach(const QString &rotated, dir.entryList(QStringList() << fi.fileName() + ".*", QDir::Files))
+        QFile::remove(dir.absoluteFilePath(rotated));
+    }
+  }
+
+  QByteArray log_sink::records_since(qint64 msecs) const {
+    // Oldest rotated file first, files may be missing
+    const QString base = _file.fileName();
+    QStringList files;
+    for (int i = _max_files - 1; i >= 1; --i)
+      files << QString("%1.%2").arg(base).arg(i);
+    files << base;
+
+    QByteArray result;
+    logging_info_log_entry entry;
+    foreach(const QString &file_name, files) {
+      QFile f(file_name);
+      if (!f.open(QIODevice::ReadOnly))
+        continue;
+
+      const QByteArray data = f.readAll();
+      const char *p = data.constData(), *end = p + data.size();
+      while (p < end && *p == logs_tag) {
+        const char *record = p++;
+        quint64 length;
+        if (!read_varint(p, end, length) || length > (quint64)(end - p))
+          break;
+        
+        // Coalesced records count by their last occurrence
+        if (entry.ParseFromArray(p, (int)length) && 
+            std::max(entry.time_msecs(), entry.last_time_msecs()) >= msecs)
+          result.append(record, (int)(p + length - record));
+        p += length;
+      }
+    }
+    return result;
+  }
+}
@@ -1,162 +1,241 @@
-/** @file
-  * @copyright Copyright (c) 2013 PROFACTOR GmbH. All rights reserved. 
-  *
-  * Redistribution and use in source and binary forms, with or without
-  * modification, are permitted provided that the following conditions are
-  * met:
-  *
-  *     * Redistributions of source code must retain the above copyright
-  * notice, this list of conditions and the following disclaimer.
-  *     * Redistributions in binary form must reproduce the above
-  * copyright notice, this list of conditions and the following disclaimer
-  * in the documentation and/or other materials provided with the
-  * distribution.
-  *     * Neither the name of Profactor GmbH nor the names of its
-  * contributors may be used to endorse or promote products derived from
-  * this software without specific prior written permission.
-  *
-  * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
-  * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
-  * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
-  * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
-  * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
-  * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
-  * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
-  * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
-  * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
-  * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
-  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
-  *
-  * @authors christoph.kopf@profactor.at
-  *          florian.eckerstorfer@profactor.at
-  */
-
-#include "logging_dialog.h"
-#include "ui_logging_dialog.h"
-#include "types.h"
-
-#include "log.pb.h"
-
-#include <QDateTime>
-#include <QFile>
-#include <QFileDialog>
-
-#include <fstream>
-
-namespace ReconstructMeGUI {
-
-  logging_dialog::logging_dialog(std::shared_ptr<reme_resource_manager> rm, QWidget *parent, Qt::WindowFlags f) : 
-    window_dialog(parent, f), 
-    _rm(rm),
-    _ui(new Ui::logging_widget)
-  {
-    _ui->setupUi(this);
-
-    _log_model = new QStandardItemModel(0, 3, parent);
-    _log_model->setHeaderData(0, Qt::Horizontal, tr("Severity"));
-    _log_model->setHeaderData(1, Qt::Horizontal, tr("Timestamp"));
-    _log_model->setHeaderData(2, Qt::Horizontal, tr("Message"));
-
-    _proxy_model = new QSortFilterProxyModel(parent);
-    _proxy_model->setSourceModel(_log_model);
-    _proxy_model->setDynamicSortFilter(true);
-
-    _ui->logtableview->horizontalHeader()->setResizeMode(QHeaderView::ResizeToContents);
-    _ui->logtableview->horizontalHeader()->setStretchLastSection(true);
-    _ui->logtableview->verticalHeader()->setResizeMode(QHeaderView::ResizeToContents);    
-   
-    _ui->logtableview->setModel(_proxy_model);
-    _ui->logtableview->horizontalHeader()->setSortIndicator(1, Qt::AscendingOrder);
-
-    setModal(false);
-
-    connect(_ui->btnClear, SIGNAL(clicked()), SLOT(clear_log()));
-    connect(_ui->btnSave, SIGNAL(clicked()), SLOT(save_log()));
-    qRegisterMetaType<init_t>( "reme_log_severity_t" );
-    connect(_rm.get(), SIGNAL(log_message(reme_log_severity_t, const QString &)), SLOT(add_log_message(reme_log_severity_t, const QString &)));
-  }
-
-  logging_dialog::~logging_dialog() 
-  {
-    delete _ui;
-  }
-
-  void logging_dialog::add_log_message(reme_log_severity_t sev, const QString &log) {
-    QStyle *style = this->style();
-
-    QString sev_str;
-    QIcon sev_icon;
-
-    switch (sev) {
-      case REME_LOG_SEVERITY_INFO:
-        sev_str = tr("Info");
-        sev_icon = style->standardIcon(QStyle::SP_MessageBoxInformation);
-        break;
-
-      case REME_LOG_SEVERITY_WARNING:
-        sev_str = tr("Warning");
-        sev_icon = style->standardIcon(QStyle::SP_MessageBoxWarning);
-        break;
-
-      case REME_LOG_SEVERITY_ERROR:
-        sev_str = tr("Error");
-        sev_icon = style->standardIcon(QStyle::SP_MessageBoxCritical);
-        break;
-    }
-
-    QList< QStandardItem *> items;
-    
-    QStandardItem *sev_item = new QStandardItem(sev_icon, sev_str);
-    QStandardItem *date_item = new QStandardItem(QDateTime::currentDateTime().toString());
-    QStandardItem *message_item = new QStandardItem(log);
-
-    sev_item->setEditable(false);
-    date_item->setEditable(false);
-    message_item->setEditable(false);
-
-    items.push_back(sev_item);
-    items.push_back(date_item);
-    items.push_back(message_item);
-
-    _log_model->insertRow(0, items);
-  }
-
-  void logging_dialog::clear_log() {
-    _log_model->removeRows(0, _log_model->rowCount());
-  }
-  
-  void logging_dialog::save_log() {
-    QString file_name = QFileDialog::getSaveFileName(this, tr("Save log"),
-                                                 QDir::currentPath(),
-                                                 tr("Text File (*.log)"),
-                                                 0);
-    if (file_name.isEmpty())
-      return;
-
-    logging_info log;
-    logging_info_log_entry *log_entry;
-    
-    for(int row = 0; row < _log_model->rowCount(); row++) {
-      log_entry = log.add_logs();
-
-      logging_info::severity sev;
-
-      QString txt = _log_model->item(row, 0)->text();
-      if (txt == "Info")
-        sev = logging_info::INFO;
-      else if (txt == "Warning")
-        sev = logging_info::WARNING;
-      else 
-        sev = logging_info::ERROR;
-
-      log_entry->set_sev(sev);
-      log_entry->set_date(_log_model->item(row, 1)->text().toStdString());
-      log_entry->set_log(_log_model->item(row, 2)->text().toStdString());
-    }
-
-    std::ofstream ost;
-    ost.open(file_name.toStdString());
-    ost << log.SerializePartialAsString();
-    ost.close();
-  }
-}
\ No newline at end of file
+/** @file
+  * @copyright Copyright (c) 2013 PROFACTOR GmbH. All rights reserved. 
+  *
+  * Redistribution and use in source and binary forms, with or without
+  * modification, are permitted provided that the following conditions are
+  * met:
+  *
+  *     * Redistributions of source code must retain the above copyright
+  * notice, this list of conditions and the following disclaimer.
+  *     * Redistributions in binary form must reproduce the above
+  * copyright notice, this list of conditions and the following disclaimer
+  * in the documentation and/or other materials provided with the
+  * distribution.
+  *     * Neither the name of Profactor GmbH nor the names of its
+  * contributors may be used to endorse or promote products derived from
+  * this software without specific prior written permission.
+  *
+  * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  *
+  * @authors christoph.kopf@profactor.at
+  *          florian.eckerstorfer@profactor.at
+  */
+
+#include "logging_dialog.h"
+#include "ui_logging_dialog.h"
+#include "log_model.h"
+#include "log_file_model.h"
+#include "types.h"
+
+#include "log.pb.h"
+
+#include <QDateTime>
+#include <QFile>
+#include <QFileDialog>
+#include <QFileInfo>
+#include <QMessageBox>
+
+#include <fstream>
+
+namespace ReconstructMeGUI {
+
+  logging_dialog::logging_dialog(std::shared_ptr<reme_resource_manager> rm, QWidget *parent, Qt::WindowFlags f) : 
+    window_dialog(parent, f), 
+    _rm(rm),
+    _ui(new Ui::logging_widget),
+    _columns_sized(false)
+  {
+    _ui->setupUi(this);
+
+    _log_model = new log_model(20000, 16 * 1024 * 1024, this);
+    _file_model = new log_file_model(this);
+
+    // Rows have uniform height, columns are sized once the first batch arrives
+    _ui->logtableview->horizontalHeader()->setResizeMode(QHeaderView::Interactive);
+    _ui->logtableview->horizontalHeader()->setStretchLastSection(true);
+    _ui->logtableview->verticalHeader()->setResizeMode(QHeaderView::Fixed);    
+    _ui->logtableview->verticalHeader()->setDefaultSectionSize(_ui->logtableview->fontMetrics().height() + 6);
+   
+    _ui->logtableview->setModel(_log_model);
+    _ui->logtableview->horizontalHeader()->setSortIndicator(log_model::TIMESTAMP_COLUMN, Qt::AscendingOrder);
+
+    setModal(false);
+
+    connect(_ui->btnClear, SIGNAL(clicked()), SLOT(clear_log()));
+    connect(_ui->btnSave, SIGNAL(clicked()), SLOT(save_log()));
+    connect(_ui->btnOpen, SIGNAL(clicked()), SLOT(open_log()));
+    connect(_ui->btnLive, SIGNAL(clicked()), SLOT(show_live_log()));
+    connect(_file_model, SIGNAL(indexed(int)), SLOT(log_file_indexed(int)));
+    connect(_log_model, SIGNAL(flushed()), SLOT(log_flushed()));
+
+    // Apply the filter once typing pauses
+    _filter_timer = new QTimer(this);
+    _filter_timer->setSingleShot(true);
+    _filter_timer->setInterval(250);
+    connect(_filter_timer, SIGNAL(timeout()), SLOT(apply_filter()));
+    connect(_ui->searchLE, SIGNAL(textChanged(const QString &)), SLOT(filter_changed()));
+    connect(_ui->severityCB, SIGNAL(currentIndexChanged(int)), SLOT(apply_filter()));
+    connect(_ui->timeCB, SIGNAL(currentIndexChanged(int)), SLOT(apply_filter()));
+    qRegisterMetaType<init_t>( "reme_log_severity_t" );
+    connect(_rm.get(), SIGNAL(log_message(reme_log_severity_t, const QString &)), SLOT(add_log_message(reme_log_severity_t, const QString &)));
+    connect(_rm.get(), SIGNAL(log_repeated(reme_log_severity_t, const QString &, int, qint64, qint64)), SLOT(add_repeated_log_message(reme_log_severity_t, const QString &, int, qint64, qint64)));
+  }
+
+  logging_dialog::~logging_dialog() 
+  {
+    delete _ui;
+  }
+
+  void logging_dialog::add_log_message(reme_log_severity_t sev, const QString &log) {
+    _log_model->append(sev, log);
+  }
+
+  void logging_dialog::add_repeated_log_message(reme_log_severity_t sev, const QString &log, int count, qint64 first_msecs, qint64 last_msecs) {
+    _log_model->append(sev, log, count, first_msecs, last_msecs);
+  }
+
+  void logging_dialog::log_flushed() {
+    if (!_log_model->filter().is_empty())
+      _ui->matchesLabel->setText(tr("%1 of %2").arg(_log_model->num_matches()).arg(_log_model->size()));
+
+    if (_columns_sized)
+      return;
+    
+    _ui->logtableview->resizeColumnToContents(log_model::SEVERITY_COLUMN);
+    _ui->logtableview->resizeColumnToContents(log_model::TIMESTAMP_COLUMN);
+    _columns_sized = true;
+  }
+
+  void logging_dialog::filter_changed() {
+    _filter_timer->start();
+  }
+
+  void logging_dialog::apply_filter() {
+    _filter_timer->stop();
+
+    log_index::query q;
+    q.text = _ui->searchLE->text().trimmed();
+
+    switch (_ui->severityCB->currentIndex()) {
+      case 1:
+        q.severities = log_index::WARNING_MASK | log_index::ERROR_MASK;
+        break;
+      case 2:
+        q.severities = log_index::ERROR_MASK;
+        break;
+    }
+
+    static const qint64 spans_msecs[] = {0, 5 * 60 * 1000, 60 * 60 * 1000, 24 * 60 * 60 * 1000};
+    const int t = _ui->timeCB->currentIndex();
+    if (t > 0)
+      q.from_msecs = QDateTime::currentMSecsSinceEpoch() - spans_msecs[t];
+
+    _log_model->set_filter(q);
+
+    if (q.is_empty())
+      _ui->matchesLabel->clear();
+    else
+      _ui->matchesLabel->setText(tr("%1 of %2").arg(_log_model->num_matches()).arg(_log_model->size()));
+  }
+
+  void logging_dialog::clear_log() {
+    _log_model->clear();
+  }
+  
+  void logging_dialog::save_log() {
+    QString file_name = QFileDialog::getSaveFileName(this, tr("Save log"),
+                                                 QDir::currentPath(),
+                                                 tr("Text File (*.log)"),
+                                                 0);
+    if (file_name.isEmpty())
+      return;
+
+    logging_info log;
+    logging_info_log_entry *log_entry;
+    
+    _log_model->flush();
+    for(int i = 0; i < _log_model->size(); i++) {
+      const log_model::entry &e = _log_model->at(i);
+      log_entry = log.add_logs();
+
+      logging_info::severity sev;
+      switch (e.sev) {
+        case REME_LOG_SEVERITY_INFO:
+          sev = logging_info::INFO;
+          break;
+        case REME_LOG_SEVERITY_WARNING:
+          sev = logging_info::WARNING;
+          break;
+        default:
+          sev = logging_info::ERROR;
+          break;
+      }
+
+      log_entry->set_sev(sev);
+      log_entry->set_date(QDateTime::fromMSecsSinceEpoch(e.msecs).toString().toStdString());
+      log_entry->set_log(e.message.toStdString());
+      log_entry->set_time_msecs(e.msecs);
+      if (e.count > 1) {
+        log_entry->set_repeat_count(e.count);
+        log_entry->set_last_time_msecs(e.last_msecs);
+      }
+    }
+
+    std::ofstream ost;
+    ost.open(file_name.toStdString(), std::ios::out | std::ios::binary);
+    ost << log.SerializePartialAsString();
+    ost.close();
+  }
+
+  void logging_dialog::open_log() {
+    QString file_name = QFileDialog::getOpenFileName(this, tr("Open log"),
+                                                 QFileInfo(_rm->log_file()).absolutePath(),
+                                                 tr("Log Files (*.log *.rmlog *.rmlog.*);;All Files (*)"),
+                                                 0);
+    if (file_name.isEmpty())
+      return;
+
+    if (!_file_model->open(file_name)) {
+      QMessageBox::warning(this, tr("Open log"), tr("Could not open %1").arg(file_name));
+      return;
+    }
+
+    _ui->logtableview->setSortingEnabled(false);
+    _ui->logtableview->setModel(_file_model);
+    _ui->severityCB->setEnabled(false);
+    _ui->timeCB->setEnabled(false);
+    _ui->searchLE->setEnabled(false);
+    _ui->btnClear->setEnabled(false);
+    _ui->btnSave->setEnabled(false);
+    _ui->btnLive->setEnabled(true);
+    _ui->matchesLabel->setText(tr("Indexing %1").arg(QFileInfo(file_name).fileName()));
+  }
+
+  void logging_dialog::log_file_indexed(int num_records) {
+    _ui->matchesLabel->setText(tr("%1 entries in %2").arg(num_records).arg(QFileInfo(_file_model->path()).fileName()));
+  }
+
+  void logging_dialog::show_live_log() {
+    _ui->logtableview->setModel(_log_model);
+    _file_model->close();
+
+    _ui->logtableview->setSortingEnabled(true);
+    _ui->severityCB->setEnabled(true);
+    _ui->timeCB->setEnabled(true);
+    _ui->searchLE->setEnabled(true);
+    _ui->btnClear->setEnabled(true);
+    _ui->btnSave->setEnabled(true);
+    _ui->btnLive->setEnabled(false);
+    apply_filter();
+  }
+}
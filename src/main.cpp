@@ -1,81 +1,146 @@
-/** @file
-  * @copyright Copyright (c) 2013 PROFACTOR GmbH. All rights reserved. 
-  *
-  * Redistribution and use in source and binary forms, with or without
-  * modification, are permitted provided that the following conditions are
-  * met:
-  *
-  *     * Redistributions of source code must retain the above copyright
-  * notice, this list of conditions and the following disclaimer.
-  *     * Redistributions in binary form must reproduce the above
-  * copyright notice, this list of conditions and the following disclaimer
-  * in the documentation and/or other materials provided with the
-  * distribution.
-  *     * Neither the name of Profactor GmbH nor the names of its
-  * contributors may be used to endorse or promote products derived from
-  * this software without specific prior written permission.
-  *
-  * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
-  * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
-  * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
-  * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
-  * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
-  * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
-  * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
-  * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
-  * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
-  * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
-  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
-  *
-  * @authors christoph.kopf@profactor.at
-  *          florian.eckerstorfer@profactor.at
-  */
-
-#include <QApplication>
-#include <QFile>
-#include <QSplashScreen>
-
-#include "settings.h"
-#include "strings.h"
-#include "reconstructme.h"
-#include "defines.h"
-
-#define SPLASH_MSG_ALIGNMENT Qt::AlignBottom | Qt::AlignLeft
-
-#if _WIN32 && !RECONSTRUCTMEQT_ENABLE_CONSOLE
-  #define WIN32_LEAN_AND_MEAN
-  #include <windows.h>
-  int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR, int) 
-{
-    int argc = 0;
-    char **argv = 0;
-#else
-  int main(int argc, char *argv[]) 
-{
-#endif
-
-  using namespace ReconstructMeGUI;
-
-  QApplication app(argc, argv);
-
-  // Splashscreen
-  QPixmap splashPix(":/images/splash_screen.png");
-  QSplashScreen *sc = new QSplashScreen(splashPix);
-  sc->setAutoFillBackground(false);
-  sc->showMessage(welcome_tag, SPLASH_MSG_ALIGNMENT);
-  sc->show();
-
-  // global style sheet
-  QFile style_file(style_sheet_file_tag);
-  if(style_file.open(QFile::ReadOnly)) {
-    app.setStyle("plastique");
-    app.setStyleSheet(style_file.readAll());
-  }
-
-  // MainWindow
-  reconstructme reme;
-  sc->finish(&reme);
-  reme.show();
-
-  return app.exec();
-}
+/** @file
+  * @copyright Copyright (c) 2013 PROFACTOR GmbH. All rights reserved. 
+  *
+  * Redistribution and use in source and binary forms, with or without
+  * modification, are permitted provided that the following conditions are
+  * met:
+  *
+  *     * Redistributions of source code must retain the above copyright
+  * notice, this list of conditions and the following disclaimer.
+  *     * Redistributions in binary form must reproduce the above
+  * copyright notice, this list of conditions and the following disclaimer
+  * in the documentation and/or other materials provided with the
+  * distribution.
+  *     * Neither the name of Profactor GmbH nor the names of its
+  * contributors may be used to endorse or promote products derived from
+  * this software without specific prior written permission.
+  *
+  * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  *
+  * @authors christoph.kopf@profactor.at
+  *          florian.eckerstorfer@profactor.at
+  */
+
+#include <QApplication>
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QFile>
+#include <QSplashScreen>
+#include <QStringList>
+#include <QTimer>
+
+#include "settings.h"
+#include "settings_store.h"
+#include "strings.h"
+#include "reconstructme.h"
+#include "batch_reconstruction.h"
+#include "batch_scheduler.h"
+#include "kernel_cache.h"
+#include "defines.h"
+
+#include <iostream>
+
+#define SPLASH_MSG_ALIGNMENT Qt::AlignBottom | Qt::AlignLeft
+
+#if _WIN32 && !RECONSTRUCTMEQT_ENABLE_CONSOLE
+  #define WIN32_LEAN_AND_MEAN
+  #include <windows.h>
+  int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR, int) 
+{
+    int argc = __argc;
+    char **argv = __argv;
+#else
+  int main(int argc, char *argv[]) 
+{
+#endif
+
+  using namespace ReconstructMeGUI;
+
+  const qint64 process_start_msecs = QDateTime::currentMSecsSinceEpoch();
+
+  QStringList args;
+  for (int i = 0; i < argc; ++i)
+    args << QString::fromLocal8Bit(argv[i]);
+
+  // Concurrent headless reconstructions from a job manifest
+  QString manifest;
+  if (batch_scheduler::requested(args, manifest)) {
+    QCoreApplication app(argc, argv);
+    kernel_cache(kernel_cache::default_root()).export_environment();
+
+    batch_scheduler scheduler;
+    QString error;
+    if (!scheduler.load_manifest(manifest, error)) {
+      std::cerr << error.toStdString() << std::endl;
+      return 2;
+    }
+
+    QObject::connect(&scheduler, SIGNAL(finished(int)), &app, SLOT(quit()), Qt::QueuedConnection);
+    QTimer::singleShot(0, &scheduler, SLOT(run()));
+    app.exec();
+
+    return scheduler.succeeded() ? 0 : 1;
+  }
+
+  // Headless reconstruction without any widgets
+  if (batch_options::requested(args)) {
+    QCoreApplication app(argc, argv);
+    kernel_cache(kernel_cache::default_root()).export_environment();
+
+    batch_options o;
+    QString error;
+    if (!batch_options::parse(args, o, error)) {
+      std::cerr << error.toStdString() << std::endl << batch_options::usage();
+      return 2;
+    }
+
+    batch_reconstruction batch(o);
+    QObject::connect(&batch, SIGNAL(finished(int)), &app, SLOT(quit()), Qt::QueuedConnection);
+    QTimer::singleShot(0, &batch, SLOT(run()));
+    app.exec();
+
+    return batch.succeeded() ? 0 : 1;
+  }
+
+  QApplication app(argc, argv);
+
+  // Settings are read once and written back in the background from here on
+  settings_store::instance();
+
+  // The OpenCL runtimes read their cache locations from the environment, 
+  // set them once before any resource manager or worker thread exists
+  kernel_cache(kernel_cache::default_root()).export_environment();
+
+  // Splashscreen
+  QPixmap splashPix(":/images/splash_screen.png");
+  QSplashScreen *sc = new QSplashScreen(splashPix);
+  sc->setAutoFillBackground(false);
+  sc->showMessage(welcome_tag, SPLASH_MSG_ALIGNMENT);
+  sc->show();
+
+  // global style sheet
+  QFile style_file(style_sheet_file_tag);
+  if(style_file.open(QFile::ReadOnly)) {
+    app.setStyle("plastique");
+    app.setStyleSheet(style_file.readAll());
+  }
+
+  // MainWindow
+  reconstructme reme(process_start_msecs);
+  sc->finish(&reme);
+  reme.show();
+
+  const int result = app.exec();
+  settings_store::instance().flush();
+  return result;
+}
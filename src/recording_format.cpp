@@ -0,0 +1,168 @@
+/** @file
+  * @copyright Copyright (c) 2013 PROFACTOR GmbH. All rights reserved. 
+  *
+  * Redistribution and use in source and binary forms, with or without
+  * modification, are permitted provided that the following conditions are
+  * met:
+  *
+  *     * Redistributions of source code must retain the above copyright
+  * notice, this list of conditions and the following disclaimer.
+  *     * Redistributions in binary form must reproduce the above
+  * copyright notice, this list of conditions and the following disclaimer
+  * in the documentation and/or other materials provided with the
+  * distribution.
+  *     * Neither the name of Profactor GmbH nor the names of its
+  * contributors may be used to endorse or promote products derived from
+  * this software without specific prior written permission.
+  *
+  * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  *
+  * @authors christoph.kopf@profactor.at
+  *          florian.eckerstorfer@profactor.at
+  */
+
+#include "recording_format.h"
+
+#include <QBuffer>
+#include <QImage>
+
+#include <cstring>
+#include <limits>
+
+#define DEFLATE_LEVEL 1
+#define JPEG_QUALITY 90
+
+namespace ReconstructMeGUI {
+  namespace recording {
+
+    void encode_image(
+      int type, const void *data, int length, 
+      int width, int height, int channels, int num_bytes_per_channel, int row_stride, 
+      bool lossy, recorded_image &img) 
+    {
+      img.set_type(type);
+      img.set_width(width);
+      img.set_height(height);
+      img.set_channels(channels);
+      img.set_num_bytes_per_channel(num_bytes_per_channel);
+      img.set_row_stride(row_stride);
+
+      if (num_bytes_per_channel == 2 && row_stride * height <= length) {
+        // Neighboring depth samples are highly correlated, deflating the 
+        // differences compresses considerably better than the samples.
+        QByteArray delta(length, 0);
+        for (int y = 0; y < height; ++y) {
+          const unsigned short *src = reinterpret_cast<const unsigned short*>(static_cast<const char*>(data) + y * row_stride);
+          unsigned short *dst = reinterpret_cast<unsigned short*>(delta.data() + y * row_stride);
+          unsigned short prev = 0;
+          for (int x = 0; x < width * channels; ++x) {
+            dst[x] = src[x] - prev;
+            prev = src[x];
+          }
+        }
+        QByteArray packed = qCompress(delta, DEFLATE_LEVEL);
+        img.set_enc(recorded_image::DELTA_ZLIB);
+        img.set_data(packed.constData(), packed.size());
+        return;
+      }
+
+      if (lossy && channels == 3 && num_bytes_per_channel == 1) {
+        QImage rgb(static_cast<const uchar*>(data), width, height, row_stride, QImage::Format_RGB888);
+        QByteArray jpeg;
+        QBuffer buffer(&jpeg);
+        buffer.open(QIODevice::WriteOnly);
+        if (rgb.save(&buffer, "JPG", JPEG_QUALITY)) {
+          img.set_enc(recorded_image::JPEG);
+          img.set_data(jpeg.constData(), jpeg.size());
+          return;
+        }
+      }
+
+      QByteArray packed = qCompress(static_cast<const uchar*>(data), length, DEFLATE_LEVEL);
+      img.set_enc(recorded_image::ZLIB);
+      img.set_data(packed.constData(), packed.size());
+    }
+
+    /** Bytes covered by the header geometry, -1 if it is inconsistent */
+    static qint64 image_bytes(const recorded_image &img) 
+    {
+      if (img.width() <= 0 || img.height() <= 0 || img.channels() <= 0 || img.num_bytes_per_channel() <= 0)
+        return -1;
+
+      const qint64 row_bytes = (qint64)img.width() * img.channels() * img.num_bytes_per_channel();
+      const qint64 bytes = (qint64)img.row_stride() * img.height();
+      if (img.row_stride() < row_bytes || bytes > std::numeric_limits<int>::max())
+        return -1;
+      return bytes;
+    }
+
+    bool decode_image(const recorded_image &img, QByteArray &data) 
+    {
+      const std::string &payload = img.data();
+
+      // Recordings may be truncated or forged, the header has to match the payload
+      const qint64 bytes = image_bytes(img);
+      if (bytes < 0)
+        return false;
+
+      switch (img.enc()) {
+        case recorded_image::RAW:
+          if ((qint64)payload.size() < bytes)
+            return false;
+          data = QByteArray(payload.data(), (int)payload.size());
+          return true;
+
+        case recorded_image::ZLIB:
+          data = qUncompress(reinterpret_cast<const uchar*>(payload.data()), (int)payload.size());
+          return data.size() >= bytes;
+
+        case recorded_image::DELTA_ZLIB: {
+          if (img.num_bytes_per_channel() != 2)
+            return false;
+
+          data = qUncompress(reinterpret_cast<const uchar*>(payload.data()), (int)payload.size());
+          if (data.size() < bytes)
+            return false;
+
+          for (int y = 0; y < img.height(); ++y) {
+            unsigned short *row = reinterpret_cast<unsigned short*>(data.data() + y * img.row_stride());
+            unsigned short prev = 0;
+            for (int x = 0; x < img.width() * img.channels(); ++x) {
+              row[x] += prev;
+              prev = row[x];
+            }
+          }
+          return true;
+        }
+
+        case recorded_image::JPEG: {
+          if (img.channels() != 3 || img.num_bytes_per_channel() != 1)
+            return false;
+
+          QImage rgb = QImage::fromData(reinterpret_cast<const uchar*>(payload.data()), (int)payload.size(), "JPG");
+          if (rgb.isNull() || rgb.width() != img.width() || rgb.height() != img.height())
+            return false;
+          
+          rgb = rgb.convertToFormat(QImage::Format_RGB888);
+          const int row_bytes = img.width() * 3;
+          data.resize((int)bytes);
+          for (int y = 0; y < img.height(); ++y)
+            memcpy(data.data() + y * img.row_stride(), rgb.constScanLine(y), row_bytes);
+          return true;
+        }
+      }
+
+      return false;
+    }
+  }
+}
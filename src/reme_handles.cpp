@@ -0,0 +1,124 @@
+/** @file
+  * @copyright Copyright (c) 2013 PROFACTOR GmbH. All rights reserved. 
+  *
+  * Redistribution and use in source and binary forms, with or without
+  * modification, are permitted provided that the following conditions are
+  * met:
+  *
+  *     * Redistributions of source code must retain the above copyright
+  * notice, this list of conditions and the following disclaimer.
+  *     * Redistributions in binary form must reproduce the above
+  * copyright notice, this list of conditions and the following disclaimer
+  * in the documentation and/or other materials provided with the
+  * distribution.
+  *     * Neither the name of Profactor GmbH nor the names of its
+  * contributors may be used to endorse or promote products derived from
+  * this software without specific prior written permission.
+  *
+  * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  *
+  * @authors christoph.kopf@profactor.at
+  *          florian.eckerstorfer@profactor.at
+  */
+
+#include "reme_handles.h"
+
+#include <QMutexLocker>
+
+namespace ReconstructMeGUI {
+
+  options_pool::lease::lease(options_pool *pool, int generation, reme_options_t o) : 
+    _pool(pool), _generation(generation), _o(o), _valid(true) 
+  {}
+
+  options_pool::lease::lease(lease &&other) : 
+    _pool(other._pool), _generation(other._generation), _o(other._o), _valid(other._valid) 
+  {
+    other._valid = false;
+  }
+
+  options_pool::lease::~lease() {
+    give_back();
+  }
+
+  options_pool::lease &options_pool::lease::operator=(lease &&other) {
+    if (this != &other) {
+      give_back();
+      _pool = other._pool;
+      _generation = other._generation;
+      _o = other._o;
+      _valid = other._valid;
+      other._valid = false;
+    }
+    return *this;
+  }
+
+  void options_pool::lease::give_back() {
+    if (_valid)
+      _pool->give_back(_generation, _o);
+    _valid = false;
+  }
+
+  options_pool::options_pool() : _c(0), _generation(0), _num_created(0)
+  {}
+
+  options_pool::~options_pool() {
+    reset(0);
+  }
+
+  void options_pool::reset(reme_context_t c) {
+    QMutexLocker lock(&_m);
+    
+    for (int i = 0; i < _idle.size(); ++i)
+      reme_options_destroy(_c, &_idle[i]);
+    _idle.clear();
+
+    _c = c;
+    _generation++;
+    _num_created = 0;
+  }
+
+  options_pool::lease options_pool::acquire() {
+    QMutexLocker lock(&_m);
+
+    if (_c == 0)
+      return lease();
+
+    if (!_idle.isEmpty()) {
+      reme_options_t o = _idle.back();
+      _idle.pop_back();
+      return lease(this, _generation, o);
+    }
+
+    reme_options_t o;
+    if (!REME_SUCCESS(reme_options_create(_c, &o)))
+      return lease();
+
+    _num_created++;
+    return lease(this, _generation, o);
+  }
+
+  int options_pool::num_created() const {
+    QMutexLocker lock(&_m);
+    return _num_created;
+  }
+
+  void options_pool::give_back(int generation, reme_options_t o) {
+    QMutexLocker lock(&_m);
+    
+    // Objects of a previous context were released together with it. A new 
+    // context may reuse the old handle value, only the generation tells them apart.
+    if (generation == _generation)
+      _idle.push_back(o);
+  }
+}
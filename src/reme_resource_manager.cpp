@@ -1,432 +1,1064 @@
-/** @file
-  * @copyright Copyright (c) 2013 PROFACTOR GmbH. All rights reserved. 
-  *
-  * Redistribution and use in source and binary forms, with or without
-  * modification, are permitted provided that the following conditions are
-  * met:
-  *
-  *     * Redistributions of source code must retain the above copyright
-  * notice, this list of conditions and the following disclaimer.
-  *     * Redistributions in binary form must reproduce the above
-  * copyright notice, this list of conditions and the following disclaimer
-  * in the documentation and/or other materials provided with the
-  * distribution.
-  *     * Neither the name of Profactor GmbH nor the names of its
-  * contributors may be used to endorse or promote products derived from
-  * this software without specific prior written permission.
-  *
-  * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
-  * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
-  * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
-  * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
-  * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
-  * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
-  * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
-  * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
-  * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
-  * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
-  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
-  *
-  * @authors christoph.kopf@profactor.at
-  *          florian.eckerstorfer@profactor.at
-  */
-  
-#pragma once
-
-#define STATUS_MSG_DURATION 2000
-#define FPS_MODULO 15
-
-#include "reme_resource_manager.h"
-#include "settings.h"
-#include "strings.h"
-
-#include <QDebug>
-#include <QCoreApplication>
-#include <QSettings>
-#include <QImage>
-#include <QtConcurrentRun>
-
-#include <reconstructmesdk/reme.h>
-
-#include <sstream>
-#include <iostream>
-
-namespace ReconstructMeGUI {
-
-  void reme_log(reme_log_severity_t sev, const char *message, void *user_data)  {
-    reme_resource_manager *rm = static_cast<reme_resource_manager*>(user_data);
-    rm->new_log_message(sev, QString(message));
-  }
-
-  reme_resource_manager::reme_resource_manager() : 
-    _has_valid_license(false),
-    _c(0)
-  {
-    reme_context_create(&_c);
-  }
-
-  reme_resource_manager::~reme_resource_manager() {
-    if (_c != 0)
-      reme_context_destroy(&_c);
-  }
-
-  void reme_resource_manager::new_log_message(reme_log_severity_t sev, const QString &log) {
-    emit log_message(sev, log);
-  }
-
-  void reme_resource_manager::initialize() {
-    bool success = false;
-
-    _has_sensor = false;
-    _has_compiled_context = false;
-    _has_volume = false;
-
-    emit initializing_sdk();
-
-    if (_c != 0)
-      reme_context_destroy(&_c);
-
-    reme_context_create(&_c);
-    reme_context_set_log_callback(_c, reme_log, this);
-    
-    emit initializing(LICENSE);
-    success = apply_license();
-    emit initialized(LICENSE, success);
-    
-    emit initializing(OPENCL);
-    success = compile_context();
-    emit initialized(OPENCL, success);
-    
-    emit initializing(SENSOR);
-    success = open_sensor();
-    emit initialized(SENSOR, success);
-    
-    success = _has_compiled_context && _has_sensor && _has_volume;
-
-    if (success) {
-      reme_surface_create(_c, &_p);
-    }
-    emit sdk_initialized(success);
-  }
-
-  bool reme_resource_manager::open_sensor() {
-    bool success = true;
-    
-    // can not initialize sensor is no compiled context is available
-    if (!_has_compiled_context) success = false;
-
-    // create and open a sensor from settings
-    QSettings settings(QSettings::IniFormat, QSettings::UserScope, profactor_tag, reme_tag);
-    QString sensor_path = settings.value(sensor_path_tag, sensor_path_default_tag).toString();
-    success = success && REME_SUCCESS(reme_sensor_create(_c, sensor_path.toStdString().c_str(), true, &_s));
-    success = success && REME_SUCCESS(reme_sensor_open(_c, _s));
-   
-    if (success)
-    {
-      int w, h;
-      bool supports_depth, supports_aux;
-
-      reme_options_t o;
-      reme_options_create(_c, &o);
-      reme_sensor_bind_capture_options(_c, _s, o);
-
-      // AUXILIARY image
-      reme_options_get_bool(_c, o, "frame_info.supports_aux", &supports_aux);
-      if (supports_aux) {
-        reme_options_get_int(_c, o, "frame_info.aux_size.width", &w);
-        reme_options_get_int(_c, o, "frame_info.aux_size.height", &h);
-      }
-      
-      // DEPTH image
-      reme_options_get_bool(_c, o, "frame_info.supports_depth", &supports_depth);
-      if (supports_depth) {
-        reme_options_get_int(_c, o, "frame_info.depth_size.width", &w);
-        reme_options_get_int(_c, o, "frame_info.depth_size.height", &h);
-      }
-    }
-
-    _has_sensor = success;
-    return _has_sensor;
-  }
-
-  bool reme_resource_manager::apply_license() {
-    bool success;
-
-    reme_license_t l;
-    success = REME_SUCCESS(reme_license_create(_c, &l));
-    
-    // Set licence
-    QSettings settings(QSettings::IniFormat, QSettings::UserScope, profactor_tag, reme_tag);
-    QString licence_file = settings.value(license_file_tag, license_file_default_tag).toString();    
-    reme_error_t error = reme_license_authenticate(_c, l, licence_file.toStdString().c_str());
-    if (error == REME_ERROR_INVALID_LICENSE)
-      success = false;
-    else if (error == REME_ERROR_UNSPECIFIED) 
-      success = false;
-    
-    _has_valid_license = success;
-
-    return success;
-  }
-
-  bool reme_resource_manager::compile_context()
-  {
-    bool success = true;
-
-    // reload settings
-    QSettings settings(QSettings::IniFormat, QSettings::UserScope, profactor_tag, reme_tag);
-
-    // Create empty options binding
-    reme_options_t o;
-    success = success && REME_SUCCESS(reme_options_create(_c, &o));
-
-    success = success && REME_SUCCESS(reme_context_bind_reconstruction_options(_c, o));
-
-    // load options if config_path already set
-    std::string path = settings.value(config_path_tag, config_path_default_tag).toString().toStdString();
-    if (path != config_path_default_tag) {
-      success = success && REME_SUCCESS(reme_options_load_from_file(_c, o, path.c_str()));
-    }
-
-    // apply selected opencl_device
-    int device_id = settings.value(opencl_device_tag, opencl_device_default_tag).toInt();
-    std::stringstream str_stream;
-    str_stream << device_id;
-    success = success && REME_SUCCESS(reme_options_set(_c, o, "device_id", str_stream.str().c_str()));
-
-    // Compile for OpenCL device using modified options
-    success = success && REME_SUCCESS(reme_context_compile(_c));
-
-    if (!_has_volume) {
-      success = success && REME_SUCCESS(reme_volume_create(_c, &_v));
-      _has_volume = true;
-    }
-
-    _has_compiled_context = success;
-    return _has_compiled_context;
-  }
-
-  void reme_resource_manager::set_frame_grabber(std::shared_ptr<frame_grabber> fg) {
-    _fg = std::shared_ptr<frame_grabber>(fg);
-  }
-
-  void reme_resource_manager::start_scanning() {
-    reme_sensor_set_trackhint(_c, _s, REME_SENSOR_TRACKHINT_USE_GLOBAL);
-
-    _fg->request(REME_IMAGE_DEPTH);
-    connect(_fg.get(), SIGNAL(frames_updated()), SLOT(scan()));
-
-    _lost_track_prev = true;
-    _cnt = 0;
-    _c0 = clock();
-  }
-
-  void reme_resource_manager::stop_scanning() {
-    _fg->release(REME_IMAGE_DEPTH);
-    disconnect(_fg.get(), SIGNAL(frames_updated()), this, SLOT(scan()));
-    current_fps(0);
-  }
-
-  void reme_resource_manager::scan() {
-    bool success = true;
-
-    _cnt++;
-    if (_cnt % FPS_MODULO == 0) {
-      emit current_fps((float)_cnt/(((float)(clock()-_c0))/CLOCKS_PER_SEC));
-      _c0 = clock();
-      _cnt = 0;
-    }
-
-    reme_error_t track_error = reme_sensor_track_position(_c, _s);
-    if (REME_SUCCESS(track_error)) {
-      // Track camera success (engine step)
-      if (_lost_track_prev) {
-        // track found
-        _lost_track_prev = false;
-      }
-      // Update volume with depth data from the current sensor perspective
-      success = success && REME_SUCCESS(reme_sensor_update_volume(_c, _s));
-    }
-    else if (!_lost_track_prev) {
-      // track lost
-      _lost_track_prev = true;
-    }
-  }
-
-  void reme_resource_manager::generate_surface(float face_decimation)
-  {
-    std::string msg;
-    
-    // options
-    reme_options_t o;
-    reme_options_create(_c, &o);
-
-    reme_context_bind_reconstruction_options(_c, o);    
-    
-    // volume information
-    int res_x, res_y, res_z;
-    int min_x, min_y, min_z;
-    int max_x, max_y, max_z;
-    reme_options_get_int(_c, o, "volume.resolution.x", &res_x);
-    reme_options_get_int(_c, o, "volume.resolution.y", &res_y);
-    reme_options_get_int(_c, o, "volume.resolution.z", &res_z);
-    reme_options_get_int(_c, o, "volume.minimum_corner.x", &min_x);
-    reme_options_get_int(_c, o, "volume.minimum_corner.y", &min_y);
-    reme_options_get_int(_c, o, "volume.minimum_corner.z", &min_z);
-    reme_options_get_int(_c, o, "volume.maximum_corner.x", &max_x);
-    reme_options_get_int(_c, o, "volume.maximum_corner.y", &max_y);
-    reme_options_get_int(_c, o, "volume.maximum_corner.z", &max_z);
-
-    float vox_x, vox_y, vox_z;
-    vox_x = std::abs(max_x - min_x) / (float)res_x;
-    vox_y = std::abs(max_y - min_y) / (float)res_y;
-    vox_z = std::abs(max_z - min_z) / (float)res_z;
-
-    float min_vox = std::min(vox_x, std::min(vox_y, vox_z));
-    float merge_radius = min_vox * 0.1f;
-
-    // generation options
-    generation_options go;
-    go.set_merge_duplicate_vertices(true);
-    go.set_merge_radius(merge_radius);
-    go.SerializeToString(&msg);
-    reme_surface_bind_generation_options(_c, _p, o);
-    reme_options_set_bytes(_c, o, msg.c_str(), msg.size());
-
-    const unsigned *faces;
-    const float *points, *normals;
-    int num_point_coordinates, num_normals_coordinates, num_triangle_indices;
-    int num_points, num_normals, num_faces;
-    
-    bool has_surface = REME_SUCCESS(reme_surface_generate(_c, _p, _v));
-
-    if(has_surface)
-    {
-      // decimation options
-      if (0.f < face_decimation && face_decimation < 1.f) 
-      {
-        reme_surface_get_triangles(_c, _p, &faces, &num_triangle_indices);
-        num_faces = num_triangle_indices / 3;
-        
-        decimation_options deco;
-        deco.set_maximum_faces(num_faces * face_decimation);
-        deco.SerializeToString(&msg);
-        
-        reme_surface_bind_decimation_options(_c, _p, o);
-        reme_options_set_bytes(_c, o, msg.c_str(), msg.size());
-        has_surface = REME_SUCCESS(reme_surface_decimate(_c, _p));
-      }
-    }
-    
-    if (has_surface)
-    {
-      // retrieve data
-      reme_surface_get_points(_c, _p, &points, &num_point_coordinates);
-      reme_surface_get_normals(_c, _p, &normals, &num_normals_coordinates);
-      reme_surface_get_triangles(_c, _p, &faces, &num_triangle_indices);
-    
-      num_points = num_point_coordinates / 4;
-      num_normals = num_normals_coordinates / 4;
-      num_faces  = num_triangle_indices / 3;
-    }
-    emit surface(has_surface, points, num_points, normals, num_normals, faces, num_faces);
-  }
-
-  void reme_resource_manager::save(const QString &filename) {
-    // Transform the mesh from world space to CAD space, so external viewers
-    // can cope better with the result.
-    float mat[16];
-    reme_transform_set_predefined(_c, REME_TRANSFORM_WORLD_TO_CAD, mat);
-    reme_surface_transform(_c, _p, mat);
-
-    reme_surface_save_to_file(_c, _p, filename.toStdString().c_str());
-  }
-
-  void reme_resource_manager::reset_volume() {
-    reme_volume_reset(_c, _v);
-    reme_sensor_reset(_c, _s);
-  }
-
-  void reme_resource_manager::get_version(std::string& version) {
-    int length;
-    const char* data;
-    reme_context_get_version(_c, &data, &length);
-
-    version = data;
-  }
-
-  void reme_resource_manager::get_opencl_info(opencl_info &ocl) {
-    const void *bytes;
-    int length;
-
-    reme_options_t o;
-    reme_options_create(_c, &o);
-
-    reme_context_bind_opencl_info(_c, o);
-
-    reme_options_get_bytes(_c, o, &bytes, &length); 
-
-    ocl.ParseFromArray(bytes, length);
-  }
-
-  void reme_resource_manager::get_hardware_hashes(hardware &hashes) {
-    const void *bytes;
-    int length;
-
-    reme_options_t o;
-    reme_options_create(_c, &o);
-
-    reme_license_t l;
-    reme_license_create(_c, &l);
-    reme_license_bind_hardware_hashes(_c, l, o);
-
-    reme_options_get_bytes(_c, o, &bytes, &length); 
-
-    hashes.ParseFromArray(bytes, length);
-  }
-
-  bool reme_resource_manager::has_valid_license() const {
-    return _has_valid_license;
-  }
-
-  reme_calibrator_t reme_resource_manager::new_calibrator() const {
-    if (_has_compiled_context && _has_sensor) {
-      reme_calibrator_t calib;
-      reme_calibrator_create(_c, &calib);
-      return calib;
-    }
-    else 
-      return REME_ERROR_UNSPECIFIED;
-  }
-
-  void reme_resource_manager::destroy_calibrator(reme_calibrator_t calib) {
-    if (_has_compiled_context)
-      reme_calibrator_destroy(_c, &calib);
-  }
-
-  reme_image_t reme_resource_manager::new_image() const {
-    if (_has_compiled_context) {
-      reme_image_t img;
-      reme_image_create(_c, &img);
-      return img;
-    }
-    else 
-      return REME_ERROR_UNSPECIFIED;
-  }
-
-  void reme_resource_manager::destroy_image(reme_image_t img) {
-    reme_image_destroy(_c, &img);
-  }
-
-  const reme_context_t reme_resource_manager::context() const{
-    return _c;
-  }
-
-  const reme_sensor_t reme_resource_manager::sensor() const{
-    return _s;
-  }
-
-  const reme_volume_t reme_resource_manager::volume() const{
-    return _v;
-  }
+/** @file
+  * @copyright Copyright (c) 2013 PROFACTOR GmbH. All rights reserved. 
+  *
+  * Redistribution and use in source and binary forms, with or without
+  * modification, are permitted provided that the following conditions are
+  * met:
+  *
+  *     * Redistributions of source code must retain the above copyright
+  * notice, this list of conditions and the following disclaimer.
+  *     * Redistributions in binary form must reproduce the above
+  * copyright notice, this list of conditions and the following disclaimer
+  * in the documentation and/or other materials provided with the
+  * distribution.
+  *     * Neither the name of Profactor GmbH nor the names of its
+  * contributors may be used to endorse or promote products derived from
+  * this software without specific prior written permission.
+  *
+  * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  *
+  * @authors christoph.kopf@profactor.at
+  *          florian.eckerstorfer@profactor.at
+  */
+  
+#pragma once
+
+#define STATUS_MSG_DURATION 2000
+#define FPS_MODULO 15
+
+#include "reme_resource_manager.h"
+#include "frame_recorder.h"
+#include "settings.h"
+#include "strings.h"
+
+#include <QDebug>
+#include <QCoreApplication>
+#include <QImage>
+#include <QFileInfo>
+#include <QFile>
+#include <QDir>
+#include <QTemporaryFile>
+#include <QDateTime>
+#include <QElapsedTimer>
+#include <QStringList>
+#include <QtConcurrentRun>
+#include <QVector>
+
+#include <reconstructmesdk/reme.h>
+
+#include <sstream>
+#include <iostream>
+
+namespace ReconstructMeGUI {
+
+  void reme_log(reme_log_severity_t sev, const char *message, void *user_data)  {
+    reme_resource_manager *rm = static_cast<reme_resource_manager*>(user_data);
+    rm->new_log_message(sev, QString(message));
+  }
+
+  reme_resource_manager::reme_resource_manager(const QString &name) : 
+    _c(0),
+    _has_compiled_context(false),
+    _has_sensor(false),
+    _has_volume(false),
+    _has_valid_license(false),
+    _has_surface(false),
+    _has_mesh(false),
+    _merge_radius(0.f),
+    _awaiting_first_frame(false),
+    _tune_target_fps(0),
+    _kernel_cache(kernel_cache::default_root()),
+    _device_profile(device_profile::default_path()),
+    _log_sink(new log_sink(log_sink::default_dir(), name)),
+    _trajectory(new trajectory_writer()),
+    _log_flush_timer(new QTimer(this))
+  {
+    qRegisterMetaType<init_t>("init_t");
+    qRegisterMetaType<qint64>("qint64");
+
+    _log_sink->start(QThread::LowPriority);
+    _log_flush_timer->setInterval(1000);
+    connect(_log_flush_timer, SIGNAL(timeout()), SLOT(flush_log()));
+    _log_flush_timer->start();
+
+    reme_context_create(&_c);
+    _options.reset(_c);
+  }
+
+  reme_resource_manager::~reme_resource_manager() {
+    _trajectory->close();
+    _generation_binding.reset();
+    _decimation_binding.reset();
+    _license.reset();
+    _options.reset(0);
+    if (_c != 0)
+      reme_context_destroy(&_c);
+    flush_log();
+    _log_sink->stop();
+  }
+
+  void reme_resource_manager::override_setting(const QString &tag, const QVariant &value) {
+    _overrides[tag] = value;
+  }
+
+  QVariant reme_resource_manager::setting(const char *tag, const QVariant &default_value) const {
+    if (_overrides.contains(tag))
+      return _overrides.value(tag);
+
+    return _settings.value(tag, default_value);
+  }
+
+  void reme_resource_manager::new_log_message(reme_log_severity_t sev, const QString &log) {
+    QVector<log_record> records;
+    {
+      QMutexLocker lock(&_log_mutex);
+      _log_coalescer.add(sev, log, _log_sink->now_us(), records);
+    }
+    publish_log(records);
+  }
+
+  void reme_resource_manager::flush_log() {
+    QVector<log_record> records;
+    {
+      QMutexLocker lock(&_log_mutex);
+      _log_coalescer.flush(_log_sink->now_us(), records);
+    }
+    publish_log(records);
+  }
+
+  void reme_resource_manager::publish_log(const QVector<log_record> &records) {
+    for (int i = 0; i < records.size(); ++i) {
+      const log_record &r = records[i];
+      _log_sink->push(r);
+      if (r.count == 1)
+        emit log_message(r.sev, r.message);
+      else
+        emit log_repeated(r.sev, r.message, r.count, _log_sink->to_msecs(r.first_us), _log_sink->to_msecs(r.last_us));
+    }
+  }
+
+  QString reme_resource_manager::log_file() const {
+    return _log_sink->path();
+  }
+
+  QString reme_resource_manager::file_stamp(const QString &path) {
+    QFileInfo fi(path);
+    if (!fi.isFile())
+      return QString();
+    return QString("%1:%2").arg(fi.lastModified().toMSecsSinceEpoch()).arg(fi.size());
+  }
+
+  reme_resource_manager::configuration reme_resource_manager::requested_configuration() const {
+    configuration c;
+    c.license = setting(license_file_tag, license_file_default_tag).toString();
+    c.license_stamp = file_stamp(c.license);
+    c.config = setting(config_path_tag, config_path_default_tag).toString();
+    c.config_stamp = file_stamp(c.config);
+    c.device = setting(opencl_device_tag, opencl_device_default_tag).toInt();
+    c.sensor = setting(sensor_path_tag, sensor_path_default_tag).toString();
+    c.sensor_stamp = file_stamp(c.sensor);
+    c.realtime = setting(replay_realtime_tag, replay_realtime_default_tag).toBool();
+    return c;
+  }
+
+  void reme_resource_manager::initialize() {
+    _startup_timer.start();
+    _awaiting_first_frame = false;
+    _settings = settings_store::instance().current();
+
+    const configuration req = requested_configuration();
+    
+    // Only rebuild resources whose inputs changed. A new context has to be 
+    // licensed again and invalidates volume, surface and sensor.
+    const bool rebuild_context = 
+      !_has_compiled_context || 
+      req.config != _applied.config || req.config_stamp != _applied.config_stamp ||
+      req.device != _applied.device;
+    const bool rebuild_license = 
+      rebuild_context || 
+      req.license != _applied.license || req.license_stamp != _applied.license_stamp;
+    const bool rebuild_sensor = 
+      rebuild_context || !_has_sensor ||
+      req.sensor != _applied.sensor || req.sensor_stamp != _applied.sensor_stamp ||
+      req.realtime != _applied.realtime;
+
+    emit initializing_sdk();
+
+    if (rebuild_context) {
+      _has_sensor = false;
+      _has_compiled_context = false;
+      _has_volume = false;
+      _has_surface = false;
+      _has_mesh = false;
+      _player.reset();
+
+      // Handles have to be released before their context
+      _generation_binding.reset();
+      _decimation_binding.reset();
+      _license.reset();
+      _options.reset(0);
+      if (_c != 0)
+        reme_context_destroy(&_c);
+
+      reme_context_create(&_c);
+      reme_context_set_log_callback(_c, reme_log, this);
+      _options.reset(_c);
+
+      std::string version;
+      get_version(version);
+      if (!_kernel_cache.validate(QString::fromStdString(version)))
+        new_log_message(REME_LOG_SEVERITY_INFO, "Kernel cache reset: " + _kernel_cache.root());
+      _device_profile.validate(QString::fromStdString(version));
+    } 
+    else if (rebuild_sensor && _has_sensor) {
+      _player.reset();
+      reme_sensor_destroy(_c, &_s);
+      _has_sensor = false;
+    }
+
+    // Startup dependency graph. License and compilation share the context and 
+    // run in sequence, sensor preparation does not touch the context and runs 
+    // alongside. The SDK requires a compiled context to open the sensor.
+    QVector<init_step> steps(4);
+    steps[0] = init_step(LICENSE, true, rebuild_license, &reme_resource_manager::apply_license, _has_valid_license);
+    steps[1] = init_step(OPENCL, true, rebuild_context, &reme_resource_manager::compile_context, _has_compiled_context);
+    steps[2] = init_step(SENSOR, false, rebuild_sensor, &reme_resource_manager::prepare_sensor, true);
+    steps[3] = init_step(SENSOR, true, rebuild_sensor, &reme_resource_manager::open_sensor, _has_sensor);
+    steps[1].deps << 0;
+    steps[3].deps << 1 << 2;
+
+    QStringList report;
+    run_steps(steps, report);
+
+    if (rebuild_license) {
+      _applied.license = req.license;
+      _applied.license_stamp = req.license_stamp;
+    }
+    if (rebuild_context && _has_compiled_context) {
+      _applied.config = req.config;
+      _applied.config_stamp = req.config_stamp;
+      _applied.device = req.device;
+    }
+    if (rebuild_sensor && _has_sensor) {
+      _applied.sensor = req.sensor;
+      _applied.sensor_stamp = req.sensor_stamp;
+      _applied.realtime = req.realtime;
+    }
+
+    new_log_message(REME_LOG_SEVERITY_INFO, "Initialization: " + report.join(", "));
+    
+    const bool success = _has_compiled_context && _has_sensor && _has_volume;
+    _awaiting_first_frame = success;
+
+    if (success && !_has_surface)
+      _has_surface = prepare_surface();
+    emit sdk_initialized(success);
+  }
+
+  void reme_resource_manager::reload_config() {
+    _settings = settings_store::instance().current();
+    const configuration req = requested_configuration();
+
+    // Anything but an edit of the compiled config file goes through initialize
+    if (!_has_compiled_context || req.config == config_path_default_tag ||
+        req.config != _applied.config || req.device != _applied.device) 
+    {
+      initialize();
+      return;
+    }
+    if (req.config_stamp == _applied.config_stamp)
+      return;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    config_options::values_t values;
+    QString error;
+    if (!config_options::parse_file(req.config, values, error)) {
+      new_log_message(REME_LOG_SEVERITY_WARNING, "Configuration not reloaded: " + error);
+      return;
+    }
+
+    const QStringList changed = config_options::diff(_applied_options, values);
+    QStringList restart;
+    foreach (const QString &path, changed) {
+      // Removed options would have to be reset to their defaults
+      if (!values.contains(path) || !config_options::is_live(path))
+        restart << path;
+    }
+    if (!restart.isEmpty()) {
+      emit config_restart_required(restart);
+      return;
+    }
+
+    bool success = true;
+    if (!changed.isEmpty()) {
+      options_pool::lease o = _options.acquire();
+      success = success && o.valid();
+      success = success && REME_SUCCESS(reme_context_bind_reconstruction_options(_c, o.get()));
+      foreach (const QString &path, changed) {
+        const std::string value = config_options::unquote(values[path]).toStdString();
+        success = success && REME_SUCCESS(reme_options_set(_c, o.get(), path.toStdString().c_str(), value.c_str()));
+      }
+    }
+    if (!success) {
+      new_log_message(REME_LOG_SEVERITY_WARNING, "Configuration: live update rejected, restart required");
+      emit config_restart_required(changed);
+      return;
+    }
+
+    _applied.config_stamp = req.config_stamp;
+    _applied_options = values;
+    new_log_message(REME_LOG_SEVERITY_INFO, 
+      QString("Configuration: applied %1 option(s) live in %2 ms").arg(changed.size()).arg(timer.elapsed()));
+  }
+
+  void reme_resource_manager::profile_devices() {
+    // Device names come from the main context, each measurement creates its own
+    opencl_info ocl;
+    get_opencl_info(ocl);
+    const QString config = settings_store::instance().value(config_path_tag, config_path_default_tag).toString();
+    QtConcurrent::run(this, &reme_resource_manager::run_profile, ocl, config);
+  }
+
+  void reme_resource_manager::run_profile(opencl_info ocl, QString config_path) {
+    for (int i = 0; i < ocl.devices_size(); ++i) {
+      const QString name = QString::fromStdString(ocl.devices(i).name());
+      QString resolution;
+      const float fps = device_profile::measure(i, config_path, resolution);
+      if (fps < 0.f) {
+        new_log_message(REME_LOG_SEVERITY_WARNING, "Device profile: " + name.trimmed() + " failed");
+        continue;
+      }
+      _device_profile.insert(name, resolution, fps);
+      new_log_message(REME_LOG_SEVERITY_INFO, 
+        QString("Device profile: %1 %2 fps at %3").arg(name.trimmed()).arg(fps, 0, 'f', 1).arg(resolution));
+    }
+    emit devices_profiled();
+  }
+
+  void reme_resource_manager::tune_config(double target_fps) {
+    static const int num_frames = 100;
+    _tune_target_fps = target_fps;
+
+    // Live frames are taken from the grab loop, which owns the sensor
+    const QString sensor_path = setting(sensor_path_tag, sensor_path_default_tag).toString();
+    if (!sensor_path.endsWith(recording_suffix_tag, Qt::CaseInsensitive)) {
+      if (_fg && _fg->is_grabbing())
+        _fg->capture_raw_depth(num_frames);
+      else
+        tuning_frames_captured(QVector<QByteArray>(), 0, 0);
+      return;
+    }
+
+    // Recordings are replayed from the start with a player of their own
+    QVector<QByteArray> frames;
+    frame_player player;
+    int w = 0, h = 0;
+    if (player.open(sensor_path, frame_player::AS_FAST_AS_POSSIBLE) && player.image_size(REME_IMAGE_RAW_DEPTH, w, h)) {
+      recording::frame f;
+      while (frames.size() < num_frames && player.next_frame(f)) {
+        for (int i = 0; i < f.images.size(); ++i)
+          if (f.images[i].type == REME_IMAGE_RAW_DEPTH)
+            frames.push_back(f.images[i].data);
+      }
+    }
+    tuning_frames_captured(frames, w, h);
+  }
+
+  void reme_resource_manager::tuning_frames_captured(const QVector<QByteArray> &frames, int width, int height) {
+    if (frames.isEmpty()) {
+      new_log_message(REME_LOG_SEVERITY_WARNING, "Tuning: no depth frames available from the current sensor");
+      emit config_tuned(0, 0, 0, -1.f);
+      return;
+    }
+
+    config_tuner tuner(
+      setting(config_path_tag, config_path_default_tag).toString(),
+      setting(opencl_device_tag, opencl_device_default_tag).toInt());
+    tuner.set_frame_size(width, height);
+    foreach (const QByteArray &f, frames)
+      tuner.add_frame(f);
+
+    new_log_message(REME_LOG_SEVERITY_INFO, 
+      QString("Tuning: captured %1 frames, target %2 fps").arg(tuner.num_frames()).arg(_tune_target_fps, 0, 'f', 1));
+    QtConcurrent::run(this, &reme_resource_manager::run_tuning, tuner, (float)_tune_target_fps);
+  }
+
+  void reme_resource_manager::run_tuning(config_tuner tuner, float target_fps) {
+    QVector<config_tuner::candidate> measured;
+    const config_tuner::candidate best = tuner.tune(target_fps, measured);
+
+    foreach (const config_tuner::candidate &c, measured) {
+      const QString result = c.fps < 0.f ? QString("failed") : QString("%1 fps").arg(c.fps, 0, 'f', 1);
+      new_log_message(REME_LOG_SEVERITY_INFO, 
+        QString("Tuning: %1x%2x%3 (%4 MB) %5").arg(c.x).arg(c.y).arg(c.z).arg(c.volume_mb).arg(result));
+    }
+    emit config_tuned(best.x, best.y, best.z, best.fps);
+  }
+
+  float reme_resource_manager::device_fps(const opencl_info &ocl, int device_id) const {
+    if (device_id < 0 || device_id >= ocl.devices_size())
+      return -1.f;
+    return _device_profile.fps(QString::fromStdString(ocl.devices(device_id).name()), _volume_resolution);
+  }
+
+  void reme_resource_manager::run_steps(QVector<init_step> &steps, QStringList &report) {
+    static const char *names[] = { "opencl", "sensor", "license" };
+
+    QSemaphore completion;
+    for (int i = 0; i < steps.size(); ++i)
+      steps[i].completion = &completion;
+
+    int num_done = 0;
+    while (num_done < steps.size()) {
+      // Launch every step whose dependencies are satisfied
+      for (int i = 0; i < steps.size(); ++i) {
+        init_step &s = steps[i];
+        if (s.started)
+          continue;
+
+        bool ready = true;
+        foreach(int d, s.deps) 
+          ready = ready && steps[d].done;
+        
+        if (ready) {
+          s.started = true;
+          s.future = QtConcurrent::run(this, &reme_resource_manager::execute_step, &s);
+        }
+      }
+
+      // Wait for whichever running step completes first
+      completion.acquire();
+      for (int i = 0; i < steps.size(); ++i) {
+        init_step &s = steps[i];
+        if (s.started && !s.done && s.finished.fetchAndAddAcquire(0) != 0) {
+          s.future.waitForFinished();
+          s.done = true;
+          num_done++;
+          break;
+        }
+      }
+    }
+
+    for (int i = 0; i < steps.size(); ++i) {
+      const init_step &s = steps[i];
+      if (!s.report_status)
+        continue;
+      if (s.execute)
+        report.push_back(QString("%1 %2 ms").arg(names[s.what]).arg(s.msecs));
+      else
+        report.push_back(QString("%1 unchanged").arg(names[s.what]));
+    }
+  }
+
+  void reme_resource_manager::execute_step(init_step *s) {
+    if (s->report_status)
+      emit initializing(s->what);
+
+    if (!s->execute) {
+      s->success = s->current_state;
+      s->msecs = 0;
+    } else {
+      QElapsedTimer t;
+      t.start();
+      s->success = (this->*(s->fn))();
+      s->msecs = (int)t.elapsed();
+    }
+
+    if (s->report_status) {
+      emit initialized(s->what, s->success);
+      emit initialization_step(s->what, s->execute, s->msecs);
+    }
+
+    s->finished.fetchAndStoreRelease(1);
+    s->completion->release();
+  }
+
+  bool reme_resource_manager::open_sensor() {
+    bool success = true;
+    
+    // can not initialize sensor is no compiled context is available
+    if (!_has_compiled_context) success = false;
+
+    // create and open a sensor from settings
+    QString sensor_path = setting(sensor_path_tag, sensor_path_default_tag).toString();
+    _player.reset();
+    if (_prepared_player) {
+      success = success && open_replay_sensor();
+    } else {
+      success = success && REME_SUCCESS(reme_sensor_create(_c, sensor_path.toStdString().c_str(), true, &_s));
+      success = success && REME_SUCCESS(reme_sensor_open(_c, _s));
+    }
+   
+    if (success)
+    {
+      int w, h;
+      bool supports_depth, supports_aux;
+
+      options_pool::lease o = _options.acquire();
+      reme_sensor_bind_capture_options(_c, _s, o.get());
+
+      // AUXILIARY image
+      reme_options_get_bool(_c, o.get(), "frame_info.supports_aux", &supports_aux);
+      if (supports_aux) {
+        reme_options_get_int(_c, o.get(), "frame_info.aux_size.width", &w);
+        reme_options_get_int(_c, o.get(), "frame_info.aux_size.height", &h);
+      }
+      
+      // DEPTH image
+      reme_options_get_bool(_c, o.get(), "frame_info.supports_depth", &supports_depth);
+      if (supports_depth) {
+        reme_options_get_int(_c, o.get(), "frame_info.depth_size.width", &w);
+        reme_options_get_int(_c, o.get(), "frame_info.depth_size.height", &h);
+      }
+    }
+
+    _has_sensor = success;
+    return _has_sensor;
+  }
+
+  bool reme_resource_manager::prepare_sensor() {
+    // Recordings are mapped and start prefetching while the context compiles
+    _prepared_player.reset();
+
+    QString sensor_path = setting(sensor_path_tag, sensor_path_default_tag).toString();
+    if (!sensor_path.endsWith(recording_suffix_tag, Qt::CaseInsensitive))
+      return true;
+
+    bool realtime = setting(replay_realtime_tag, replay_realtime_default_tag).toBool();
+
+    std::shared_ptr<frame_player> player(new frame_player());
+    if (!player->open(sensor_path, realtime ? frame_player::REALTIME : frame_player::AS_FAST_AS_POSSIBLE))
+      return false;
+
+    _prepared_player = player;
+    return true;
+  }
+
+  bool reme_resource_manager::open_replay_sensor() {
+    std::shared_ptr<frame_player> player = _prepared_player;
+    _prepared_player.reset();
+
+    int w, h;
+    if (!player->image_size(REME_IMAGE_RAW_DEPTH, w, h))
+      return false;
+
+    // External sensors receive their depth data from the application
+    bool success = REME_SUCCESS(reme_sensor_create(_c, "external", true, &_s));
+
+    options_pool::lease o = _options.acquire();
+    success = success && o.valid();
+    success = success && REME_SUCCESS(reme_sensor_bind_capture_options(_c, _s, o.get()));
+
+    std::stringstream str_w, str_h;
+    str_w << w;
+    str_h << h;
+    success = success && REME_SUCCESS(reme_options_set(_c, o.get(), "frame_info.depth_size.width", str_w.str().c_str()));
+    success = success && REME_SUCCESS(reme_options_set(_c, o.get(), "frame_info.depth_size.height", str_h.str().c_str()));
+    success = success && REME_SUCCESS(reme_sensor_open(_c, _s));
+
+    if (success)
+      _player = player;
+    
+    return success;
+  }
+
+  bool reme_resource_manager::apply_license() {
+    bool success;
+
+    // The license stays alive as long as the context is licensed
+    success = _license.create(_c, &reme_license_create);
+    
+    // Set licence
+    QString licence_file = setting(license_file_tag, license_file_default_tag).toString();    
+    reme_error_t error = reme_license_authenticate(_c, _license.get(), licence_file.toStdString().c_str());
+    if (error == REME_ERROR_INVALID_LICENSE)
+      success = false;
+    else if (error == REME_ERROR_UNSPECIFIED) 
+      success = false;
+    
+    _has_valid_license = success;
+
+    return success;
+  }
+
+  bool reme_resource_manager::compile_context()
+  {
+    bool success = true;
+
+    // Create empty options binding
+    options_pool::lease o = _options.acquire();
+    success = success && o.valid();
+
+    success = success && REME_SUCCESS(reme_context_bind_reconstruction_options(_c, o.get()));
+
+    // load options if config_path already set
+    std::string path = setting(config_path_tag, config_path_default_tag).toString().toStdString();
+    _applied_options.clear();
+    if (path != config_path_default_tag) {
+      success = success && REME_SUCCESS(reme_options_load_from_file(_c, o.get(), path.c_str()));
+
+      // Baseline for differential reloads, unparsable files always recompile
+      QString error;
+      if (success && !config_options::parse_file(QString::fromStdString(path), _applied_options, error))
+        _applied_options.clear();
+    }
+
+    // apply selected opencl_device, AUTO prefers the fastest profiled device
+    int device_id = setting(opencl_device_tag, opencl_device_default_tag).toInt();
+    if (success)
+      _volume_resolution = device_profile::volume_resolution(_c, o.get());
+    if (success && device_id == opencl_device_default_tag) {
+      opencl_info ocl;
+      get_opencl_info(ocl);
+      device_id = _device_profile.best_device(ocl, _volume_resolution);
+      if (device_id != opencl_device_default_tag) {
+        new_log_message(REME_LOG_SEVERITY_INFO, QString("Device: %1 selected from profile, %2 fps")
+          .arg(QString::fromStdString(ocl.devices(device_id).name()).trimmed())
+          .arg(_device_profile.fps(QString::fromStdString(ocl.devices(device_id).name()), _volume_resolution), 0, 'f', 1));
+      }
+    }
+    std::stringstream str_stream;
+    str_stream << device_id;
+    success = success && REME_SUCCESS(reme_options_set(_c, o.get(), "device_id", str_stream.str().c_str()));
+
+    // Identify the configuration in the kernel cache
+    QString key;
+    if (success) {
+      const void *bytes;
+      int length;
+      reme_options_get_bytes(_c, o.get(), &bytes, &length);
+
+      opencl_info ocl;
+      get_opencl_info(ocl);
+      QString device_name("auto"), driver_version;
+      if (device_id >= 0 && device_id < ocl.devices_size()) {
+        device_name = QString::fromStdString(ocl.devices(device_id).name());
+        driver_version = QString::fromStdString(ocl.devices(device_id).driver_version());
+      }
+
+      std::string version;
+      get_version(version);
+
+      key = kernel_cache::make_key(device_id, device_name, driver_version, QString::fromStdString(version), QByteArray((const char*)bytes, length));
+    }
+    const bool cached = success && _kernel_cache.contains(key);
+    const QStringList cached_files = _kernel_cache.files();
+
+    // Volume geometry only changes with a new context
+    if (success) {
+      int res_x, res_y, res_z;
+      int min_x, min_y, min_z;
+      int max_x, max_y, max_z;
+      reme_options_get_int(_c, o.get(), "volume.resolution.x", &res_x);
+      reme_options_get_int(_c, o.get(), "volume.resolution.y", &res_y);
+      reme_options_get_int(_c, o.get(), "volume.resolution.z", &res_z);
+      reme_options_get_int(_c, o.get(), "volume.minimum_corner.x", &min_x);
+      reme_options_get_int(_c, o.get(), "volume.minimum_corner.y", &min_y);
+      reme_options_get_int(_c, o.get(), "volume.minimum_corner.z", &min_z);
+      reme_options_get_int(_c, o.get(), "volume.maximum_corner.x", &max_x);
+      reme_options_get_int(_c, o.get(), "volume.maximum_corner.y", &max_y);
+      reme_options_get_int(_c, o.get(), "volume.maximum_corner.z", &max_z);
+
+      float vox_x, vox_y, vox_z;
+      vox_x = std::abs(max_x - min_x) / (float)res_x;
+      vox_y = std::abs(max_y - min_y) / (float)res_y;
+      vox_z = std::abs(max_z - min_z) / (float)res_z;
+
+      float min_vox = std::min(vox_x, std::min(vox_y, vox_z));
+      _merge_radius = min_vox * 0.1f;
+    }
+
+    // Compile for OpenCL device using modified options
+    QElapsedTimer t;
+    t.start();
+    success = success && REME_SUCCESS(reme_context_compile(_c));
+    const int msecs = (int)t.elapsed();
+
+    if (success) {
+      if (cached) {
+        new_log_message(REME_LOG_SEVERITY_INFO, 
+          QString("Compilation: %1 ms from kernel cache, %2 ms uncached").arg(msecs).arg(_kernel_cache.cold_msecs(key)));
+      } else {
+        _kernel_cache.insert(key, msecs, cached_files);
+        new_log_message(REME_LOG_SEVERITY_INFO, QString("Compilation: %1 ms, %2").arg(msecs)
+          .arg(_kernel_cache.contains(key) ? "kernel cache populated" : "not cached by the OpenCL runtime"));
+      }
+    }
+
+    if (!_has_volume) {
+      success = success && REME_SUCCESS(reme_volume_create(_c, &_v));
+      _has_volume = true;
+    }
+
+    _has_compiled_context = success;
+    return _has_compiled_context;
+  }
+
+  void reme_resource_manager::set_frame_grabber(std::shared_ptr<frame_grabber> fg) {
+    _fg = std::shared_ptr<frame_grabber>(fg);
+    connect(_fg.get(), SIGNAL(frames_updated()), SLOT(frame_arrived()));
+    connect(_fg.get(), SIGNAL(raw_depth_captured(QVector<QByteArray>, int, int)), SLOT(tuning_frames_captured(QVector<QByteArray>, int, int)));
+  }
+
+  void reme_resource_manager::frame_arrived() {
+    if (!_awaiting_first_frame)
+      return;
+
+    _awaiting_first_frame = false;
+    const int msecs = (int)_startup_timer.elapsed();
+    new_log_message(REME_LOG_SEVERITY_INFO, QString("Time to first frame: %1 ms").arg(msecs));
+    emit first_frame(msecs);
+  }
+
+  void reme_resource_manager::start_scanning() {
+    reme_sensor_set_trackhint(_c, _s, REME_SENSOR_TRACKHINT_USE_GLOBAL);
+
+    _fg->request(REME_IMAGE_DEPTH);
+    connect(_fg.get(), SIGNAL(frames_updated()), SLOT(scan()));
+
+    _lost_track_prev = true;
+    _cnt = 0;
+    _c0 = clock();
+    _scan_timer.start();
+    if (_scan_stats.start_msecs == 0)
+      _scan_stats.start_msecs = QDateTime::currentMSecsSinceEpoch();
+
+    if (!_trajectory->is_open()) 
+      open_trajectory();
+  }
+
+  void reme_resource_manager::stop_scanning() {
+    _fg->release(REME_IMAGE_DEPTH);
+    disconnect(_fg.get(), SIGNAL(frames_updated()), this, SLOT(scan()));
+    current_fps(0);
+    if (_scan_timer.isValid()) {
+      _scan_stats.msecs += _scan_timer.elapsed();
+      _scan_timer.invalidate();
+    }
+  }
+
+  void reme_resource_manager::scan() {
+    bool success = true;
+
+    _cnt++;
+    if (_cnt % FPS_MODULO == 0) {
+      emit current_fps((float)_cnt/(((float)(clock()-_c0))/CLOCKS_PER_SEC));
+      _c0 = clock();
+      _cnt = 0;
+    }
+
+    _scan_stats.frames++;
+    reme_error_t track_error = reme_sensor_track_position(_c, _s);
+
+    // Pose of this frame, also attached to the frame if it is being recorded
+    trajectory_sample t;
+    t.timestamp_us = _trajectory->now_us();
+    t.track_success = REME_SUCCESS(track_error);
+    if (REME_SUCCESS(reme_sensor_get_position(_c, _s, t.pose))) {
+      if (_trajectory->is_open())
+        _trajectory->push(t);
+      std::shared_ptr<frame_recorder> recorder = _fg->recorder();
+      if (recorder && recorder->is_recording())
+        recorder->add_pose(t.pose, t.track_success);
+    }
+    if (REME_SUCCESS(track_error)) {
+      _scan_stats.tracked++;
+      // Track camera success (engine step)
+      if (_lost_track_prev) {
+        // track found
+        _lost_track_prev = false;
+      }
+      // Update volume with depth data from the current sensor perspective
+      success = success && REME_SUCCESS(reme_sensor_update_volume(_c, _s));
+    }
+    else if (!_lost_track_prev) {
+      // track lost
+      _lost_track_prev = true;
+    }
+  }
+
+  bool reme_resource_manager::prepare_surface() {
+    bool success = REME_SUCCESS(reme_surface_create(_c, &_p));
+
+    std::string msg;
+    generation_options go;
+    go.set_merge_duplicate_vertices(true);
+    go.set_merge_radius(_merge_radius);
+    go.SerializeToString(&msg);
+
+    success = success && _generation_binding.create(_c, &reme_options_create);
+    success = success && REME_SUCCESS(reme_surface_bind_generation_options(_c, _p, _generation_binding.get()));
+    success = success && REME_SUCCESS(reme_options_set_bytes(_c, _generation_binding.get(), msg.c_str(), msg.size()));
+
+    success = success && _decimation_binding.create(_c, &reme_options_create);
+    success = success && REME_SUCCESS(reme_surface_bind_decimation_options(_c, _p, _decimation_binding.get()));
+    return success;
+  }
+
+  void reme_resource_manager::generate_surface(float face_decimation)
+  {
+    const unsigned *faces;
+    const float *points, *normals;
+    int num_point_coordinates, num_normals_coordinates, num_triangle_indices;
+    int num_points, num_normals, num_faces;
+    
+    bool has_surface = REME_SUCCESS(reme_surface_generate(_c, _p, _v));
+
+    if(has_surface)
+    {
+      // decimation options
+      if (0.f < face_decimation && face_decimation < 1.f) 
+      {
+        reme_surface_get_triangles(_c, _p, &faces, &num_triangle_indices);
+        num_faces = num_triangle_indices / 3;
+        
+        // Message and buffer keep their allocations between extractions
+        _decimation.set_maximum_faces(num_faces * face_decimation);
+        _decimation.SerializeToString(&_decimation_bytes);
+        
+        reme_options_set_bytes(_c, _decimation_binding.get(), _decimation_bytes.c_str(), _decimation_bytes.size());
+        has_surface = REME_SUCCESS(reme_surface_decimate(_c, _p));
+      }
+    }
+    
+    if (has_surface)
+    {
+      // retrieve data
+      reme_surface_get_points(_c, _p, &points, &num_point_coordinates);
+      reme_surface_get_normals(_c, _p, &normals, &num_normals_coordinates);
+      reme_surface_get_triangles(_c, _p, &faces, &num_triangle_indices);
+    
+      num_points = num_point_coordinates / 4;
+      num_normals = num_normals_coordinates / 4;
+      num_faces  = num_triangle_indices / 3;
+    }
+    _has_mesh = has_surface && num_faces > 0;
+    emit surface(has_surface, points, num_points, normals, num_normals, faces, num_faces);
+  }
+
+  void reme_resource_manager::save(const QString &filename) {
+    // Transform the mesh from world space to CAD space, so external viewers
+    // can cope better with the result.
+    float mat[16];
+    reme_transform_set_predefined(_c, REME_TRANSFORM_WORLD_TO_CAD, mat);
+    reme_surface_transform(_c, _p, mat);
+
+    reme_surface_save_to_file(_c, _p, filename.toStdString().c_str());
+  }
+
+  void reme_resource_manager::save_session(const QString &filename, const QByteArray &thumbnail_png) {
+    session_manifest manifest;
+    manifest.set_version(session::version);
+
+    std::string version;
+    get_version(version);
+    manifest.set_sdk_version(version);
+
+    opencl_info ocl;
+    get_opencl_info(ocl);
+    const int device_id = setting(opencl_device_tag, opencl_device_default_tag).toInt();
+    manifest.set_device(device_id >= 0 && device_id < ocl.devices_size() ? ocl.devices(device_id).name() : std::string("auto"));
+
+    const QString config = setting(config_path_tag, config_path_default_tag).toString();
+    QFile config_file(config);
+    if (config != config_path_default_tag && config_file.open(QIODevice::ReadOnly))
+      manifest.set_config(config_file.readAll().constData());
+    manifest.set_sensor(setting(sensor_path_tag, sensor_path_default_tag).toString().toStdString());
+
+    const settings_store::values_t values = settings_store::instance().current().values();
+    QStringList keys = values.keys();
+    keys.sort();
+    foreach (const QString &key, keys) {
+      session_setting *s = manifest.add_settings();
+      s->set_key(key.toStdString());
+      s->set_value(values.value(key).toString().toStdString());
+    }
+
+    manifest.set_created_msecs(QDateTime::currentMSecsSinceEpoch());
+    manifest.set_scan_msecs(_scan_stats.msecs + (_scan_timer.isValid() ? _scan_timer.elapsed() : 0));
+    manifest.set_num_frames(_scan_stats.frames);
+    manifest.set_num_tracked(_scan_stats.tracked);
+
+    session_writer w;
+    bool success = w.open(filename, manifest);
+
+    // A session without a mesh of the current volume is useless
+    if (success && !_has_mesh) {
+      new_log_message(REME_LOG_SEVERITY_WARNING, "Session: no surface generated since the last reset");
+      success = false;
+    }
+
+    // The SDK writes meshes to files only, go through a temporary one
+    if (success) {
+      QTemporaryFile tmp(QDir::tempPath() + "/reme_session_XXXXXX.ply");
+      success = tmp.open();
+      if (success) {
+        tmp.close();
+        QFile mesh(tmp.fileName());
+        success = REME_SUCCESS(reme_surface_save_to_file(_c, _p, tmp.fileName().toStdString().c_str())) && mesh.open(QIODevice::ReadOnly);
+        success = success && w.add_section(session_section::MESH, "mesh.ply", mesh.readAll(), true);
+      }
+    }
+
+    _trajectory->sync();
+    const QVector<trajectory_sample> poses = _trajectory->samples();
+    if (success && !poses.isEmpty()) {
+      QByteArray data = trajectory::encode_header(_trajectory->start_msecs());
+      data.resize(trajectory::header_size + poses.size() * trajectory::record_size);
+      for (int i = 0; i < poses.size(); ++i)
+        trajectory::encode(poses[i], data.data() + trajectory::header_size + i * trajectory::record_size);
+      success = w.add_section(session_section::POSES, "trajectory.rmtraj", data, true);
+    }
+
+    if (success && !thumbnail_png.isEmpty())
+      success = w.add_section(session_section::THUMBNAIL, "thumbnail.png", thumbnail_png, false);
+
+    // Only the records of this scan, the log file spans the whole application run
+    flush_log();
+    _log_sink->sync();
+    const QByteArray log = _log_sink->records_since(_scan_stats.start_msecs);
+    if (success && !log.isEmpty())
+      success = w.add_section(session_section::LOG, "session.rmlog", log, true);
+
+    success = w.close() && success;
+    if (success)
+      new_log_message(REME_LOG_SEVERITY_INFO, "Session saved: " + filename);
+    else
+      new_log_message(REME_LOG_SEVERITY_ERROR, "Session could not be written: " + filename);
+  }
+
+  void reme_resource_manager::export_trajectory(const QString &filename) {
+    _trajectory->sync();
+    const QVector<trajectory_sample> poses = _trajectory->samples();
+
+    // Poses of frames that lost track are not meaningful for downstream tools
+    bool success;
+    if (filename.endsWith(trajectory_kitti_suffix_tag, Qt::CaseInsensitive))
+      success = trajectory::export_kitti(poses, filename, true);
+    else
+      success = trajectory::export_tum(poses, _trajectory->start_msecs(), filename, true);
+
+    if (success)
+      new_log_message(REME_LOG_SEVERITY_INFO, QString("Trajectory: %1 poses exported to %2, %3 dropped")
+        .arg(poses.size()).arg(filename).arg(_trajectory->num_dropped()));
+    else
+      new_log_message(REME_LOG_SEVERITY_ERROR, "Trajectory could not be written: " + filename);
+  }
+
+  void reme_resource_manager::reset_volume() {
+    reme_volume_reset(_c, _v);
+    reme_sensor_reset(_c, _s);
+    _has_mesh = false;
+    _scan_stats = scan_stats();
+    _scan_stats.start_msecs = QDateTime::currentMSecsSinceEpoch();
+    if (_scan_timer.isValid())
+      _scan_timer.restart();
+    // One file per scan, the next start_scanning opens a new one. A reset 
+    // while scanning keeps writing to the current file.
+    if (!_scan_timer.isValid())
+      _trajectory->close();
+  }
+
+  void reme_resource_manager::open_trajectory() {
+    const QString path = trajectory_writer::default_path();
+    if (!_trajectory->open(path))
+      new_log_message(REME_LOG_SEVERITY_WARNING, "Trajectory: could not open " + path);
+  }
+
+  void reme_resource_manager::get_version(std::string& version) {
+    int length;
+    const char* data;
+    reme_context_get_version(_c, &data, &length);
+
+    version = data;
+  }
+
+  void reme_resource_manager::get_opencl_info(opencl_info &ocl) {
+    const void *bytes;
+    int length;
+
+    options_pool::lease o = _options.acquire();
+
+    reme_context_bind_opencl_info(_c, o.get());
+
+    reme_options_get_bytes(_c, o.get(), &bytes, &length); 
+
+    ocl.ParseFromArray(bytes, length);
+  }
+
+  void reme_resource_manager::get_hardware_hashes(hardware &hashes) {
+    const void *bytes;
+    int length;
+
+    options_pool::lease o = _options.acquire();
+
+    scoped_license l;
+    l.create(_c, &reme_license_create);
+    reme_license_bind_hardware_hashes(_c, l.get(), o.get());
+
+    reme_options_get_bytes(_c, o.get(), &bytes, &length); 
+
+    hashes.ParseFromArray(bytes, length);
+  }
+
+  bool reme_resource_manager::has_valid_license() const {
+    return _has_valid_license;
+  }
+
+  reme_calibrator_t reme_resource_manager::new_calibrator() const {
+    if (_has_compiled_context && _has_sensor) {
+      reme_calibrator_t calib;
+      reme_calibrator_create(_c, &calib);
+      return calib;
+    }
+    else 
+      return REME_ERROR_UNSPECIFIED;
+  }
+
+  void reme_resource_manager::destroy_calibrator(reme_calibrator_t calib) {
+    if (_has_compiled_context)
+      reme_calibrator_destroy(_c, &calib);
+  }
+
+  reme_image_t reme_resource_manager::new_image() const {
+    if (_has_compiled_context) {
+      reme_image_t img;
+      reme_image_create(_c, &img);
+      return img;
+    }
+    else 
+      return REME_ERROR_UNSPECIFIED;
+  }
+
+  void reme_resource_manager::destroy_image(reme_image_t img) {
+    reme_image_destroy(_c, &img);
+  }
+
+  const reme_context_t reme_resource_manager::context() const{
+    return _c;
+  }
+
+  const reme_sensor_t reme_resource_manager::sensor() const{
+    return _s;
+  }
+
+  const reme_volume_t reme_resource_manager::volume() const{
+    return _v;
+  }
+
+  std::shared_ptr<frame_player> reme_resource_manager::player() const {
+    return _player;
+  }
 }
\ No newline at end of file
@@ -0,0 +1,248 @@
+/** @file
+  * @copyright Copyright (c) 2013 PROFACTOR GmbH. All rights reserved. 
+  *
+  * Redistribution and use in source and binary forms, with or without
+  * modification, are permitted provided that the following conditions are
+  * met:
+  *
+  *     * Redistributions of source code must retain the above copyright
+  * notice, this list of conditions and the following disclaimer.
+  *     * Redistributions in binary form must reproduce the above
+  * copyright notice, this list of conditions and the following disclaimer
+  * in the documentation and/or other materials provided with the
+  * distribution.
+  *     * Neither the name of Profactor GmbH nor the names of its
+  * contributors may be used to endorse or promote products derived from
+  * this software without specific prior written permission.
+  *
+  * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  *
+  * @authors christoph.kopf@profactor.at
+  *          florian.eckerstorfer@profactor.at
+  */
+
+#include "session_file.h"
+
+#include <QtEndian>
+
+#include <cstring>
+
+#define DEFLATE_LEVEL 6
+
+namespace ReconstructMeGUI {
+
+  namespace session {
+    quint32 crc32(const uchar *data, qint64 length) {
+      static quint32 table[256];
+      static bool initialized = false;
+      if (!initialized) {
+        for (quint32 i = 0; i < 256; ++i) {
+          quint32 c = i;
+          for (int k = 0; k < 8; ++k)
+            c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+          table[i] = c;
+        }
+        initialized = true;
+      }
+
+      quint32 crc = 0xFFFFFFFFu;
+      for (qint64 i = 0; i < length; ++i)
+        crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+      return crc ^ 0xFFFFFFFFu;
+    }
+  }
+
+  // ==================== writer ====================
+
+  session_writer::session_writer() 
+  {}
+
+  session_writer::~session_writer() {
+    if (_file.isOpen())
+      close();
+  }
+
+  bool session_writer::open(const QString &file_name, const session_manifest &manifest) {
+    _index.Clear();
+    _file.setFileName(file_name);
+    if (!_file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+      return false;
+
+    const std::string payload = manifest.SerializeAsString();
+    _index.set_manifest_offset(session::magic_size);
+    return 
+      _file.write(session::magic, session::magic_size) == session::magic_size &&
+      write_chunk(session::CHUNK_MANIFEST, payload.data(), payload.size());
+  }
+
+  bool session_writer::add_section(session_section::section_type type, const QString &name, const QByteArray &data, bool compress) {
+    if (!_file.isOpen())
+      return false;
+
+    // Already compressed payloads such as PNG thumbnails are stored as is
+    QByteArray packed;
+    if (compress) {
+      packed = qCompress(data, DEFLATE_LEVEL);
+      compress = packed.size() < data.size();
+    }
+    const QByteArray &stored = compress ? packed : data;
+
+    session_section *s = _index.add_sections();
+    s->set_type(type);
+    s->set_name(name.toStdString());
+    s->set_offset(_file.pos());
+    s->set_stored_size(stored.size());
+    s->set_size(data.size());
+    s->set_comp(compress ? session_section::ZLIB : session_section::RAW);
+    s->set_crc32(session::crc32(reinterpret_cast<const uchar*>(stored.constData()), stored.size()));
+
+    return write_chunk(session::CHUNK_SECTION, stored.constData(), stored.size());
+  }
+
+  bool session_writer::close() {
+    if (!_file.isOpen())
+      return false;
+
+    const qint64 index_offset = _file.pos();
+    const std::string payload = _index.SerializeAsString();
+    bool success = write_chunk(session::CHUNK_INDEX, payload.data(), payload.size());
+
+    quint64 offset_le = qToLittleEndian<quint64>(index_offset);
+    success = success && _file.write(reinterpret_cast<const char*>(&offset_le), sizeof(offset_le)) == sizeof(offset_le);
+    success = success && _file.write(session::trailer_magic, session::magic_size) == session::magic_size;
+    _file.close();
+    return success;
+  }
+
+  bool session_writer::write_chunk(session::chunk_t type, const char *data, qint64 size) {
+    if (size > 0xFFFFFFFFll)
+      return false;
+
+    quint32 header[2];
+    header[0] = qToLittleEndian<quint32>(type);
+    header[1] = qToLittleEndian<quint32>((quint32)size);
+    return 
+      _file.write(reinterpret_cast<const char*>(header), sizeof(header)) == sizeof(header) &&
+      _file.write(data, size) == size;
+  }
+
+  // ==================== reader ====================
+
+  session_reader::session_reader() : _map(0), _map_size(0)
+  {}
+
+  session_reader::~session_reader() {
+    close();
+  }
+
+  bool session_reader::open(const QString &file_name) {
+    close();
+
+    _file.setFileName(file_name);
+    if (!_file.open(QIODevice::ReadOnly))
+      return false;
+
+    _map_size = _file.size();
+    _map = _file.map(0, _map_size);
+    if (_map == 0 || _map_size < session::magic_size + session::trailer_size || memcmp(_map, session::magic, session::magic_size) != 0) {
+      close();
+      return false;
+    }
+
+    // Sessions are written in one go, a missing trailer means the file is truncated
+    const uchar *trailer = _map + _map_size - session::trailer_size;
+    if (memcmp(trailer + 8, session::trailer_magic, session::magic_size) != 0) {
+      close();
+      return false;
+    }
+
+    quint32 type, size;
+    const uchar *payload;
+    const qint64 index_offset = (qint64)qFromLittleEndian<quint64>(trailer);
+    if (!read_chunk(index_offset, type, payload, size) || type != session::CHUNK_INDEX || !_index.ParseFromArray(payload, size) ||
+        !read_chunk(_index.manifest_offset(), type, payload, size) || type != session::CHUNK_MANIFEST || !_manifest.ParseFromArray(payload, size))
+    {
+      close();
+      return false;
+    }
+    return true;
+  }
+
+  void session_reader::close() {
+    if (_map)
+      _file.unmap(const_cast<uchar*>(_map));
+    _map = 0;
+    _map_size = 0;
+    _file.close();
+    _manifest.Clear();
+    _index.Clear();
+  }
+
+  const session_manifest &session_reader::manifest() const {
+    return _manifest;
+  }
+
+  const session_index &session_reader::index() const {
+    return _index;
+  }
+
+  int session_reader::find(session_section::section_type type) const {
+    for (int i = 0; i < _index.sections_size(); ++i)
+      if (_index.sections(i).type() == type)
+        return i;
+    return -1;
+  }
+
+  bool session_reader::read(int i, QByteArray &data) const {
+    if (i < 0 || i >= _index.sections_size())
+      return false;
+    const session_section &s = _index.sections(i);
+
+    quint32 type, size;
+    const uchar *payload;
+    if (!read_chunk(s.offset(), type, payload, size) || type != session::CHUNK_SECTION || size != s.stored_size() ||
+        session::crc32(payload, size) != s.crc32())
+      return false;
+
+    if (s.comp() == session_section::ZLIB)
+      data = qUncompress(payload, size);
+    else
+      data = QByteArray(reinterpret_cast<const char*>(payload), size);
+    return data.size() == s.size();
+  }
+
+  const uchar *session_reader::map(int i, qint64 &size) const {
+    if (i < 0 || i >= _index.sections_size() || _index.sections(i).comp() != session_section::RAW)
+      return 0;
+    const session_section &s = _index.sections(i);
+
+    quint32 type, chunk_size;
+    const uchar *payload;
+    if (!read_chunk(s.offset(), type, payload, chunk_size) || type != session::CHUNK_SECTION || chunk_size != s.stored_size())
+      return 0;
+
+    size = chunk_size;
+    return payload;
+  }
+
+  bool session_reader::read_chunk(qint64 offset, quint32 &type, const uchar *&payload, quint32 &size) const {
+    if (offset < 0 || offset + session::chunk_header_size > _map_size)
+      return false;
+
+    type = qFromLittleEndian<quint32>(_map + offset);
+    size = qFromLittleEndian<quint32>(_map + offset + 4);
+    payload = _map + offset + session::chunk_header_size;
+
+    return offset + session::chunk_header_size + size <= _map_size;
+  }
+}
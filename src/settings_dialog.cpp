@@ -1,178 +1,292 @@
-/** @file
-  * @copyright Copyright (c) 2013 PROFACTOR GmbH. All rights reserved. 
-  *
-  * Redistribution and use in source and binary forms, with or without
-  * modification, are permitted provided that the following conditions are
-  * met:
-  *
-  *     * Redistributions of source code must retain the above copyright
-  * notice, this list of conditions and the following disclaimer.
-  *     * Redistributions in binary form must reproduce the above
-  * copyright notice, this list of conditions and the following disclaimer
-  * in the documentation and/or other materials provided with the
-  * distribution.
-  *     * Neither the name of Profactor GmbH nor the names of its
-  * contributors may be used to endorse or promote products derived from
-  * this software without specific prior written permission.
-  *
-  * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
-  * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
-  * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
-  * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
-  * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
-  * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
-  * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
-  * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
-  * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
-  * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
-  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
-  *
-  * @authors christoph.kopf@profactor.at
-  *          florian.eckerstorfer@profactor.at
-  */
-  
-#include "settings_dialog.h"
-#include "ui_settings_dialog.h"
-#include "settings.h"
-#include "strings.h"
-#include "opencl_info.pb.h"
-
-#include <QSettings>
-#include <QFileDialog>
-#include <QFile>
-#include <QStringList>
-#include <QFileSystemWatcher>
-#include <QMessageBox>
-#include <QComboBox>
-
-#include <iostream>
-
-namespace ReconstructMeGUI {
-
-  settings_dialog::settings_dialog(std::shared_ptr<reme_resource_manager> rm, QWidget *parent) :
-    QDialog(parent),
-    _rm(rm),
-    _ui(new Ui::settings_dialog())
-  {
-    // setup this
-    _ui->setupUi(this);
-
-    _fw = new QFileSystemWatcher(this);
-    connect(_fw, SIGNAL(fileChanged(const QString &)), SLOT(apply_changed_file(const QString &)));
-
-    refresh_entries();
-  }
-
-  settings_dialog::~settings_dialog() 
-  {
-    delete _ui;
-  }
-
-  void settings_dialog::apply_changed_file(const QString &file) 
-  {
-    if (QMessageBox::Yes == QMessageBox::information(this, "File Content Changed", "File " + file + " changed. Apply Changes?", QMessageBox::Yes, QMessageBox::No))
-      QMetaObject::invokeMethod(_rm.get(), "initialize", Qt::QueuedConnection);
-  }
-
-  void settings_dialog::refresh_entries() 
-  {
-    QSettings s(QSettings::IniFormat, QSettings::UserScope, profactor_tag, reme_tag);
-
-    QString config = s.value(config_path_tag, config_path_default_tag).toString();
-    QString sensor = s.value(sensor_path_tag, sensor_path_default_tag).toString();
-    int device = s.value(opencl_device_tag, opencl_device_default_tag).toInt();
-
-    QDir dir = QDir::current();
-    dir.setFilter(QDir::Files);
-    dir.setSorting(QDir::Name);
-
-    dir.cd("cfg");
-    QStringList config_list = dir.entryList();
-    QComboBox &lw_config = *_ui->lw_config;
-    lw_config.clear();
-    lw_config.addItem("AUTO: Default configuration - 1m cubed", config_path_default_tag);
-    lw_config.setCurrentIndex(0);
-    std::for_each(config_list.begin(), config_list.end(), [&lw_config, &dir, &config](QString &c) {
-      lw_config.addItem(QFileInfo(c).completeBaseName(), dir.absoluteFilePath(c));
-      if (QString::compare(QFileInfo(config).fileName(), QFileInfo(c).fileName()) == 0)
-        lw_config.setCurrentIndex(lw_config.count()-1);
-    });
-
-    dir.cd("sensor");
-    QStringList sensor_list = dir.entryList();
-    QComboBox &lw_sensor = *_ui->lw_sensor;
-    lw_sensor.clear();
-    lw_sensor.addItem("AUTO: Let ReconstructMe look for a sensor", sensor_path_default_tag);
-    lw_sensor.setCurrentIndex(0);
-    std::for_each(sensor_list.begin(), sensor_list.end(), [&lw_sensor, &dir, &sensor](QString &s) {
-      lw_sensor.addItem(QFileInfo(s).completeBaseName(), dir.absoluteFilePath(s));
-      if (QString::compare(QFileInfo(sensor).fileName(), QFileInfo(s).fileName()) == 0)
-        lw_sensor.setCurrentIndex(lw_sensor.count()-1);
-    });
-
-    opencl_info ocl;
-    _rm->get_opencl_info(ocl);
-    QComboBox &lw_device = *_ui->lw_device;
-    lw_device.clear();
-    lw_device.addItem("AUTO: Autoselect best calculation device", -1);
-    lw_device.setCurrentIndex(0);
-    int cnt = 0;
-    std::for_each(ocl.devices().begin(), ocl.devices().end(), [&lw_device, &device, &cnt](const opencl_info_device &dev) {
-      lw_device.addItem(QString(dev.name().c_str()).trimmed(), cnt);
-      if (device == cnt) 
-        lw_device.setCurrentIndex(lw_device.count()-1);
-      cnt++;
-    });
-
-    save_settings();
-  }
-
-  void settings_dialog::save_settings() 
-  { 
-    _fw->removePaths(_fw->files()); // Remove watched paths
-
-    QDir dir = QDir::current();
-    dir.cd("cfg");
-    QString config = _ui->lw_config->itemData(_ui->lw_config->currentIndex()).value<QString>();
-    QString config_path;
-    if (QFileInfo(dir.absoluteFilePath(config)).exists() && QFileInfo(dir.absoluteFilePath(config)).isFile()) {
-      _fw->addPath(config);
-      config_path = dir.absoluteFilePath(config);
-    }
-    else {
-      config_path = config_path_default_tag;
-    }
-    
-    dir.cd("sensor");
-    QString sensor = _ui->lw_sensor->itemData(_ui->lw_sensor->currentIndex()).value<QString>();
-    QString sensor_path;
-    if (QFileInfo(dir.absoluteFilePath(sensor)).exists() && QFileInfo(dir.absoluteFilePath(sensor)).isFile()) {
-      _fw->addPath(sensor);
-      sensor_path = dir.absoluteFilePath(sensor);
-    }
-    else {
-      sensor_path = sensor_path_default_tag;
-    }
-    
-    int device = _ui->lw_device->itemData(_ui->lw_device->currentIndex()).value<int>();
-    
-    QSettings s(QSettings::IniFormat, QSettings::UserScope, profactor_tag, reme_tag);
-    s.setValue(config_path_tag, config_path);
-    s.setValue(sensor_path_tag, sensor_path);
-    s.setValue(opencl_device_tag, device);
-    s.sync();
-  }
-
-  void settings_dialog::accept()
-  {
-    save_settings();
-    QMetaObject::invokeMethod(_rm.get(), "initialize", Qt::QueuedConnection);
-    hide();
-  }
-
-  void settings_dialog::reject() 
-  {
-    hide();
-  }
-
+/** @file
+  * @copyright Copyright (c) 2013 PROFACTOR GmbH. All rights reserved. 
+  *
+  * Redistribution and use in source and binary forms, with or without
+  * modification, are permitted provided that the following conditions are
+  * met:
+  *
+  *     * Redistributions of source code must retain the above copyright
+  * notice, this list of conditions and the following disclaimer.
+  *     * Redistributions in binary form must reproduce the above
+  * copyright notice, this list of conditions and the following disclaimer
+  * in the documentation and/or other materials provided with the
+  * distribution.
+  *     * Neither the name of Profactor GmbH nor the names of its
+  * contributors may be used to endorse or promote products derived from
+  * this software without specific prior written permission.
+  *
+  * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  *
+  * @authors christoph.kopf@profactor.at
+  *          florian.eckerstorfer@profactor.at
+  */
+  
+#include "settings_dialog.h"
+#include "ui_settings_dialog.h"
+#include "settings.h"
+#include "settings_store.h"
+#include "config_tuner.h"
+#include "strings.h"
+#include "opencl_info.pb.h"
+
+#include <QFileDialog>
+#include <QFile>
+#include <QFileInfo>
+#include <QStringList>
+#include <QFileSystemWatcher>
+#include <QMessageBox>
+#include <QComboBox>
+#include <QInputDialog>
+
+#include <iostream>
+
+namespace ReconstructMeGUI {
+
+  settings_dialog::settings_dialog(std::shared_ptr<reme_resource_manager> rm, QWidget *parent) :
+    QDialog(parent),
+    _rm(rm),
+    _ui(new Ui::settings_dialog())
+  {
+    // setup this
+    _ui->setupUi(this);
+
+    _fw = new QFileSystemWatcher(this);
+    connect(_fw, SIGNAL(fileChanged(const QString &)), SLOT(apply_changed_file(const QString &)));
+    connect(_rm.get(), SIGNAL(config_restart_required(const QStringList &)), SLOT(confirm_restart(const QStringList &)));
+    connect(_rm.get(), SIGNAL(devices_profiled()), SLOT(devices_profiled()));
+    connect(_ui->btnProfile, SIGNAL(clicked()), SLOT(profile_devices()));
+    connect(_rm.get(), SIGNAL(config_tuned(int, int, int, float)), SLOT(config_tuned(int, int, int, float)));
+    connect(_ui->btnTune, SIGNAL(clicked()), SLOT(tune_config()));
+
+    refresh_entries();
+  }
+
+  settings_dialog::~settings_dialog() 
+  {
+    delete _ui;
+  }
+
+  void settings_dialog::apply_changed_file(const QString &file) 
+  {
+    // Config edits are diffed by the resource manager, which asks back if needed
+    const QString config = settings_store::instance().value(config_path_tag, config_path_default_tag).toString();
+    if (QFileInfo(file) == QFileInfo(config)) {
+      QMetaObject::invokeMethod(_rm.get(), "reload_config", Qt::QueuedConnection);
+      return;
+    }
+
+    if (QMessageBox::Yes == QMessageBox::information(this, "File Content Changed", "File " + file + " changed. Apply Changes?", QMessageBox::Yes, QMessageBox::No))
+      QMetaObject::invokeMethod(_rm.get(), "initialize", Qt::QueuedConnection);
+  }
+
+  void settings_dialog::confirm_restart(const QStringList &options)
+  {
+    QString msg = "The following options require a restart of the reconstruction:\n" + options.mid(0, 10).join("\n");
+    if (options.size() > 10)
+      msg += QString("\n... and %1 more").arg(options.size() - 10);
+    if (QMessageBox::Yes == QMessageBox::information(this, "Configuration Changed", msg + "\n\nApply Changes?", QMessageBox::Yes, QMessageBox::No))
+      QMetaObject::invokeMethod(_rm.get(), "initialize", Qt::QueuedConnection);
+  }
+
+  void settings_dialog::refresh_entries() 
+  {
+    const settings_store::snapshot s = settings_store::instance().current();
+
+    QString config = s.value(config_path_tag, config_path_default_tag).toString();
+    QString sensor = s.value(sensor_path_tag, sensor_path_default_tag).toString();
+    int device = s.value(opencl_device_tag, opencl_device_default_tag).toInt();
+
+    QDir dir = QDir::current();
+    dir.setFilter(QDir::Files);
+    dir.setSorting(QDir::Name);
+
+    dir.cd("cfg");
+    QStringList config_list = dir.entryList();
+    QComboBox &lw_config = *_ui->lw_config;
+    lw_config.clear();
+    lw_config.addItem("AUTO: Default configuration - 1m cubed", config_path_default_tag);
+    lw_config.setCurrentIndex(0);
+    std::for_each(config_list.begin(), config_list.end(), [&lw_config, &dir, &config](QString &c) {
+      lw_config.addItem(QFileInfo(c).completeBaseName(), dir.absoluteFilePath(c));
+      if (QString::compare(QFileInfo(config).fileName(), QFileInfo(c).fileName()) == 0)
+        lw_config.setCurrentIndex(lw_config.count()-1);
+    });
+
+    dir.cd("sensor");
+    QStringList sensor_list = dir.entryList();
+    QComboBox &lw_sensor = *_ui->lw_sensor;
+    lw_sensor.clear();
+    lw_sensor.addItem("AUTO: Let ReconstructMe look for a sensor", sensor_path_default_tag);
+    lw_sensor.setCurrentIndex(0);
+    std::for_each(sensor_list.begin(), sensor_list.end(), [&lw_sensor, &dir, &sensor](QString &s) {
+      lw_sensor.addItem(QFileInfo(s).completeBaseName(), dir.absoluteFilePath(s));
+      if (QString::compare(QFileInfo(sensor).fileName(), QFileInfo(s).fileName()) == 0)
+        lw_sensor.setCurrentIndex(lw_sensor.count()-1);
+    });
+
+    opencl_info ocl;
+    _rm->get_opencl_info(ocl);
+    QComboBox &lw_device = *_ui->lw_device;
+    lw_device.clear();
+    lw_device.addItem("AUTO: Autoselect best calculation device", -1);
+    lw_device.setCurrentIndex(0);
+    int cnt = 0;
+    std::for_each(ocl.devices().begin(), ocl.devices().end(), [&lw_device, &device, &cnt](const opencl_info_device &dev) {
+      lw_device.addItem(QString(dev.name().c_str()).trimmed(), cnt);
+      if (device == cnt) 
+        lw_device.setCurrentIndex(lw_device.count()-1);
+      cnt++;
+    });
+    update_device_labels(ocl);
+
+    save_settings();
+  }
+
+  void settings_dialog::update_device_labels(const opencl_info &ocl)
+  {
+    QComboBox &lw_device = *_ui->lw_device;
+    for (int i = 0; i < lw_device.count(); ++i) {
+      const int id = lw_device.itemData(i).toInt();
+      if (id < 0 || id >= ocl.devices_size())
+        continue;
+      QString label = QString(ocl.devices(id).name().c_str()).trimmed();
+      const float fps = _rm->device_fps(ocl, id);
+      if (fps >= 0.f)
+        label += QString(" - %1 fps").arg(fps, 0, 'f', 1);
+      lw_device.setItemText(i, label);
+    }
+  }
+
+  void settings_dialog::profile_devices()
+  {
+    _ui->btnProfile->setEnabled(false);
+    _ui->btnProfile->setText("Profiling...");
+    QMetaObject::invokeMethod(_rm.get(), "profile_devices", Qt::QueuedConnection);
+  }
+
+  void settings_dialog::devices_profiled()
+  {
+    _ui->btnProfile->setEnabled(true);
+    _ui->btnProfile->setText("Profile");
+
+    opencl_info ocl;
+    _rm->get_opencl_info(ocl);
+    update_device_labels(ocl);
+  }
+
+  void settings_dialog::tune_config()
+  {
+    bool ok;
+    const double target = QInputDialog::getDouble(this, "Tune Configuration", 
+      "Target frame rate (fps) for the current sensor and device:", 20., 1., 120., 1, &ok);
+    if (!ok)
+      return;
+
+    _ui->btnTune->setEnabled(false);
+    _ui->btnTune->setText("Tuning...");
+    QMetaObject::invokeMethod(_rm.get(), "tune_config", Qt::QueuedConnection, Q_ARG(double, target));
+  }
+
+  void settings_dialog::config_tuned(int x, int y, int z, float fps)
+  {
+    _ui->btnTune->setEnabled(true);
+    _ui->btnTune->setText("Tune");
+
+    if (x == 0) {
+      QMessageBox::warning(this, "Tune Configuration", "No volume resolution reached the target frame rate, see the log for the measurements.");
+      return;
+    }
+
+    const QString msg = QString("Highest resolution reaching the target: %1x%2x%3 at %4 fps.\n\nSave as new configuration?")
+      .arg(x).arg(y).arg(z).arg(fps, 0, 'f', 1);
+    if (QMessageBox::Yes != QMessageBox::information(this, "Tune Configuration", msg, QMessageBox::Yes, QMessageBox::No))
+      return;
+
+    // The tuned file is derived from the selected configuration
+    const QString base = _ui->lw_config->itemData(_ui->lw_config->currentIndex()).value<QString>();
+    QDir dir = QDir::current();
+    dir.cd("cfg");
+    const QString suffix = QFileInfo(base).suffix().isEmpty() ? QString("txt") : QFileInfo(base).suffix();
+    const QString name = QString("%1_%2x%3x%4.%5")
+      .arg(base == config_path_default_tag ? QString("default") : QFileInfo(base).completeBaseName())
+      .arg(x).arg(y).arg(z).arg(suffix);
+
+    const QString path = QFileDialog::getSaveFileName(this, "Save Configuration", dir.absoluteFilePath(name));
+    if (path.isEmpty())
+      return;
+
+    config_tuner::candidate c;
+    c.x = x;
+    c.y = y;
+    c.z = z;
+    QString error;
+    if (!config_tuner::write(base, c, path, error)) {
+      QMessageBox::warning(this, "Tune Configuration", error);
+      return;
+    }
+
+    refresh_entries();
+    const int index = _ui->lw_config->findData(QFileInfo(path).absoluteFilePath());
+    if (index >= 0)
+      _ui->lw_config->setCurrentIndex(index);
+  }
+
+  void settings_dialog::save_settings() 
+  { 
+    _fw->removePaths(_fw->files()); // Remove watched paths
+
+    QDir dir = QDir::current();
+    dir.cd("cfg");
+    QString config = _ui->lw_config->itemData(_ui->lw_config->currentIndex()).value<QString>();
+    QString config_path;
+    if (QFileInfo(dir.absoluteFilePath(config)).exists() && QFileInfo(dir.absoluteFilePath(config)).isFile()) {
+      _fw->addPath(config);
+      config_path = dir.absoluteFilePath(config);
+    }
+    else {
+      config_path = config_path_default_tag;
+    }
+    
+    dir.cd("sensor");
+    QString sensor = _ui->lw_sensor->itemData(_ui->lw_sensor->currentIndex()).value<QString>();
+    QString sensor_path;
+    if (QFileInfo(dir.absoluteFilePath(sensor)).exists() && QFileInfo(dir.absoluteFilePath(sensor)).isFile()) {
+      _fw->addPath(sensor);
+      sensor_path = dir.absoluteFilePath(sensor);
+    }
+    else {
+      sensor_path = sensor_path_default_tag;
+    }
+    
+    int device = _ui->lw_device->itemData(_ui->lw_device->currentIndex()).value<int>();
+    
+    settings_store::values_t values;
+    values.insert(config_path_tag, config_path);
+    values.insert(sensor_path_tag, sensor_path);
+    values.insert(opencl_device_tag, device);
+    settings_store::instance().set(values);
+  }
+
+  void settings_dialog::accept()
+  {
+    save_settings();
+    QMetaObject::invokeMethod(_rm.get(), "initialize", Qt::QueuedConnection);
+    hide();
+  }
+
+  void settings_dialog::reject() 
+  {
+    hide();
+  }
+
 }
\ No newline at end of file
@@ -0,0 +1,155 @@
+/** @file
+  * @copyright Copyright (c) 2013 PROFACTOR GmbH. All rights reserved. 
+  *
+  * Redistribution and use in source and binary forms, with or without
+  * modification, are permitted provided that the following conditions are
+  * met:
+  *
+  *     * Redistributions of source code must retain the above copyright
+  * notice, this list of conditions and the following disclaimer.
+  *     * Redistributions in binary form must reproduce the above
+  * copyright notice, this list of conditions and the following disclaimer
+  * in the documentation and/or other materials provided with the
+  * distribution.
+  *     * Neither the name of Profactor GmbH nor the names of its
+  * contributors may be used to endorse or promote products derived from
+  * this software without specific prior written permission.
+  *
+  * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  *
+  * @authors christoph.kopf@profactor.at
+  *          florian.eckerstorfer@profactor.at
+  */
+
+#include "settings_store.h"
+#include "settings.h"
+
+#include <QSettings>
+#include <QFileInfo>
+#include <QCoreApplication>
+#include <QtConcurrentRun>
+
+namespace ReconstructMeGUI {
+
+  settings_store &settings_store::instance() {
+    static settings_store store;
+    return store;
+  }
+
+  settings_store::settings_store() 
+  {
+    QSettings s(QSettings::IniFormat, QSettings::UserScope, profactor_tag, reme_tag);
+    _file_name = s.fileName();
+
+    const QStringList keys = s.allKeys();
+    for (int i = 0; i < keys.size(); ++i)
+      _values.insert(keys[i], s.value(keys[i]));
+
+    _persist_timer = new QTimer(this);
+    _persist_timer->setSingleShot(true);
+    _persist_timer->setInterval(500);
+    connect(_persist_timer, SIGNAL(timeout()), SLOT(persist()));
+
+    // Live in the main thread, so persisting is scheduled by its event loop
+    if (QCoreApplication::instance())
+      moveToThread(QCoreApplication::instance()->thread());
+  }
+
+  settings_store::~settings_store() {
+    flush();
+  }
+
+  QString settings_store::directory() const {
+    return QFileInfo(_file_name).absolutePath();
+  }
+
+  settings_store::snapshot settings_store::current() const {
+    QReadLocker lock(&_lock);
+    return snapshot(_values);
+  }
+
+  QVariant settings_store::value(const QString &tag, const QVariant &default_value) const {
+    QReadLocker lock(&_lock);
+    values_t::const_iterator i = _values.find(tag);
+    return i == _values.end() ? default_value : i.value();
+  }
+
+  void settings_store::set(const QString &tag, const QVariant &value) {
+    values_t values;
+    values.insert(tag, value);
+    set(values);
+  }
+
+  void settings_store::set(const values_t &values) {
+    QStringList changed_keys;
+    {
+      QWriteLocker lock(&_lock);
+      for (values_t::const_iterator i = values.begin(); i != values.end(); ++i) {
+        values_t::iterator cur = _values.find(i.key());
+        if (cur != _values.end() && cur.value() == i.value())
+          continue;
+        _values[i.key()] = i.value();
+        _dirty.insert(i.key());
+        changed_keys << i.key();
+      }
+    }
+
+    if (changed_keys.isEmpty())
+      return;
+
+    QMetaObject::invokeMethod(_persist_timer, "start", Qt::QueuedConnection);
+    emit changed(changed_keys);
+  }
+
+  void settings_store::persist() {
+    if (_persisting.isRunning()) {
+      // Keep writes in order, try again once the running write is done
+      _persist_timer->start();
+      return;
+    }
+
+    values_t values;
+    {
+      QWriteLocker lock(&_lock);
+      if (_dirty.isEmpty())
+        return;
+      foreach (const QString &key, _dirty)
+        values.insert(key, _values.value(key));
+      _dirty.clear();
+    }
+
+    _persisting = QtConcurrent::run(&settings_store::write, _file_name, values);
+  }
+
+  void settings_store::flush() {
+    _persisting.waitForFinished();
+
+    values_t values;
+    {
+      QWriteLocker lock(&_lock);
+      foreach (const QString &key, _dirty)
+        values.insert(key, _values.value(key));
+      _dirty.clear();
+    }
+
+    if (!values.isEmpty())
+      write(_file_name, values);
+  }
+
+  void settings_store::write(QString file_name, values_t values) {
+    QSettings s(file_name, QSettings::IniFormat);
+    for (values_t::const_iterator i = values.begin(); i != values.end(); ++i)
+      s.setValue(i.key(), i.value());
+    s.sync();
+  }
+}
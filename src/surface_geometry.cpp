@@ -0,0 +1,73 @@
+/** @file
+  * @copyright Copyright (c) 2013 PROFACTOR GmbH. All rights reserved. 
+  *
+  * Redistribution and use in source and binary forms, with or without
+  * modification, are permitted provided that the following conditions are
+  * met:
+  *
+  *     * Redistributions of source code must retain the above copyright
+  * notice, this list of conditions and the following disclaimer.
+  *     * Redistributions in binary form must reproduce the above
+  * copyright notice, this list of conditions and the following disclaimer
+  * in the documentation and/or other materials provided with the
+  * distribution.
+  *     * Neither the name of Profactor GmbH nor the names of its
+  * contributors may be used to endorse or promote products derived from
+  * this software without specific prior written permission.
+  *
+  * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  *
+  * @authors christoph.kopf@profactor.at
+  *          florian.eckerstorfer@profactor.at
+  */
+
+#include "surface_geometry.h"
+
+namespace ReconstructMeGUI {
+
+  osg::ref_ptr<osg::Geometry> create_surface_geometry(
+    const float *points, int num_points,
+    const float *normals, 
+    const unsigned *faces, int num_faces) 
+  {
+    osg::ref_ptr<osg::Geometry> geom = new osg::Geometry();
+    geom->setUseDisplayList(num_faces < 500000);
+    geom->setUseVertexBufferObjects(false);
+
+    typedef osg::TemplateIndexArray<unsigned int, osg::Array::UIntArrayType, 24, 4> index_array_type;
+
+    osg::ref_ptr<osg::Vec3Array> vertex_coords = new osg::Vec3Array();
+    osg::ref_ptr<osg::Vec3Array> vertex_normals = new osg::Vec3Array();
+    osg::ref_ptr<osg::DrawElementsUInt> face_to_vertex = new osg::DrawElementsUInt(osg::PrimitiveSet::TRIANGLES, 0);
+    osg::ref_ptr<index_array_type> normal_to_vertex = new index_array_type();
+
+    int i = 0;
+    while (i < num_points)
+    {
+      vertex_coords->push_back(osg::Vec3(points[i*4+0], points[i*4+1], points[i*4+2]));
+      vertex_normals->push_back(osg::Vec3(normals[i*4+0], normals[i*4+1], normals[i*4+2]));
+      normal_to_vertex->push_back(i);
+      i++;
+    }
+
+    face_to_vertex->insert(face_to_vertex->begin(), faces, faces + num_faces * 3);
+
+    geom->setVertexArray(vertex_coords);
+    geom->setNormalArray(vertex_normals);
+    geom->setNormalBinding(osg::Geometry::BIND_PER_VERTEX);
+    geom->setNormalIndices(normal_to_vertex);
+    geom->addPrimitiveSet(face_to_vertex);
+
+    return geom;
+  }
+}
@@ -0,0 +1,327 @@
+/** @file
+  * @copyright Copyright (c) 2013 PROFACTOR GmbH. All rights reserved. 
+  *
+  * Redistribution and use in source and binary forms, with or without
+  * modification, are permitted provided that the following conditions are
+  * met:
+  *
+  *     * Redistributions of source code must retain the above copyright
+  * notice, this list of conditions and the following disclaimer.
+  *     * Redistributions in binary form must reproduce the above
+  * copyright notice, this list of conditions and the following disclaimer
+  * in the documentation and/or other materials provided with the
+  * distribution.
+  *     * Neither the name of Profactor GmbH nor the names of its
+  * contributors may be used to endorse or promote products derived from
+  * this software without specific prior written permission.
+  *
+  * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+  * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+  * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+  * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+  * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+  * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+  * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+  * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+  *
+  * @authors christoph.kopf@profactor.at
+  *          florian.eckerstorfer@profactor.at
+  */
+
+#include "trajectory.h"
+#include "settings_store.h"
+
+#include <QCoreApplication>
+#include <QtEndian>
+#include <QDateTime>
+#include <QDir>
+#include <QStringList>
+#include <QTextStream>
+#include <QMutexLocker>
+
+#include <cstring>
+#include <cmath>
+
+namespace ReconstructMeGUI {
+
+  /** Power of two, about two minutes at 30 fps */
+  static const int ring_capacity = 4096;
+  static const int poll_msecs = 50;
+  /** Trajectory files kept below the settings directory */
+  static const int kept_files = 50;
+
+  namespace trajectory {
+
+    namespace {
+      void put_float(char *dst, float v) {
+        quint32 bits;
+        memcpy(&bits, &v, sizeof(bits));
+        qToLittleEndian<quint32>(bits, reinterpret_cast<uchar*>(dst));
+      }
+
+      float get_float(const uchar *src) {
+        const quint32 bits = qFromLittleEndian<quint32>(src);
+        float v;
+        memcpy(&v, &bits, sizeof(v));
+        return v;
+      }
+
+      bool open_text(QFile &f) {
+        return f.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text);
+      }
+    }
+
+    QByteArray encode_header(qint64 start_msecs) {
+      QByteArray header(header_size, 0);
+      memcpy(header.data(), magic, sizeof(magic));
+      qToLittleEndian<qint64>(start_msecs, reinterpret_cast<uchar*>(header.data() + 8));
+      return header;
+    }
+
+    void encode(const trajectory_sample &s, char *record) {
+      qToLittleEndian<qint64>(s.timestamp_us, reinterpret_cast<uchar*>(record));
+      for (int i = 0; i < 12; ++i)
+        put_float(record + 8 + 4 * i, s.pose[i]);
+      qToLittleEndian<quint32>(s.track_success ? FLAG_TRACK_SUCCESS : 0, reinterpret_cast<uchar*>(record + 8 + 48));
+    }
+
+    bool decode(const QByteArray &data, QVector<trajectory_sample> &samples, qint64 &start_msecs) {
+      samples.clear();
+      if (data.size() < header_size || memcmp(data.constData(), magic, sizeof(magic)) != 0)
+        return false;
+
+      const uchar *p = reinterpret_cast<const uchar*>(data.constData());
+      start_msecs = qFromLittleEndian<qint64>(p + 8);
+
+      // A trailing partial record is the tail of an interrupted write
+      const int n = (data.size() - header_size) / record_size;
+      samples.resize(n);
+      for (int i = 0; i < n; ++i) {
+        const uchar *r = p + header_size + i * record_size;
+        trajectory_sample &s = samples[i];
+        s.timestamp_us = qFromLittleEndian<qint64>(r);
+        for (int k = 0; k < 12; ++k)
+          s.pose[k] = get_float(r + 8 + 4 * k);
+        s.pose[12] = s.pose[13] = s.pose[14] = 0.f;
+        s.pose[15] = 1.f;
+        s.track_success = (qFromLittleEndian<quint32>(r + 8 + 48) & FLAG_TRACK_SUCCESS) != 0;
+      }
+      return true;
+    }
+
+    bool read(const QString &path, QVector<trajectory_sample> &samples, qint64 &start_msecs) {
+      QFile f(path);
+      if (!f.open(QIODevice::ReadOnly))
+        return false;
+      return decode(f.readAll(), samples, start_msecs);
+    }
+
+    bool export_tum(const QVector<trajectory_sample> &samples, qint64 start_msecs, const QString &path, bool tracked_only) {
+      QFile f(path);
+      if (!open_text(f))
+        return false;
+
+      QTextStream out(&f);
+      out.setRealNumberNotation(QTextStream::FixedNotation);
+      out << "# timestamp tx ty tz qx qy qz qw\n";
+
+      foreach (const trajectory_sample &s, samples) {
+        if (tracked_only && !s.track_success)
+          continue;
+
+        // Rotation matrix to unit quaternion
+        const float *m = s.pose;
+        double qw, qx, qy, qz;
+        const double trace = m[0] + m[5] + m[10];
+        if (trace > 0.) {
+          const double k = 0.5 / std::sqrt(trace + 1.);
+          qw = 0.25 / k;
+          qx = (m[9] - m[6]) * k;
+          qy = (m[2] - m[8]) * k;
+          qz = (m[4] - m[1]) * k;
+        } else if (m[0] > m[5] && m[0] > m[10]) {
+          const double k = 2. * std::sqrt(1. + m[0] - m[5] - m[10]);
+          qw = (m[9] - m[6]) / k;
+          qx = 0.25 * k;
+          qy = (m[1] + m[4]) / k;
+          qz = (m[2] + m[8]) / k;
+        } else if (m[5] > m[10]) {
+          const double k = 2. * std::sqrt(1. + m[5] - m[0] - m[10]);
+          qw = (m[2] - m[8]) / k;
+          qx = (m[1] + m[4]) / k;
+          qy = 0.25 * k;
+          qz = (m[6] + m[9]) / k;
+        } else {
+          const double k = 2. * std::sqrt(1. + m[10] - m[0] - m[5]);
+          qw = (m[4] - m[1]) / k;
+          qx = (m[2] + m[8]) / k;
+          qy = (m[6] + m[9]) / k;
+          qz = 0.25 * k;
+        }
+
+        out.setRealNumberPrecision(6);
+        out << (start_msecs / 1000. + s.timestamp_us / 1e6) << ' ';
+        out << m[3] / 1000. << ' ' << m[7] / 1000. << ' ' << m[11] / 1000. << ' ';
+        out.setRealNumberPrecision(9);
+        out << qx << ' ' << qy << ' ' << qz << ' ' << qw << '\n';
+      }
+      return out.status() == QTextStream::Ok;
+    }
+
+    bool export_kitti(const QVector<trajectory_sample> &samples, const QString &path, bool tracked_only) {
+      QFile f(path);
+      if (!open_text(f))
+        return false;
+
+      QTextStream out(&f);
+      out.setRealNumberNotation(QTextStream::ScientificNotation);
+      out.setRealNumberPrecision(9);
+
+      foreach (const trajectory_sample &s, samples) {
+        if (tracked_only && !s.track_success)
+          continue;
+        for (int i = 0; i < 12; ++i) {
+          // Translation column is converted to meters
+          const double v = (i % 4 == 3) ? s.pose[i] / 1000. : s.pose[i];
+          out << v << (i == 11 ? '\n' : ' ');
+        }
+      }
+      return out.status() == QTextStream::Ok;
+    }
+  }
+
+  trajectory_writer::trajectory_writer() :
+    _ring(ring_capacity),
+    _head(0),
+    _tail(0),
+    _dropped(0),
+    _stop(0),
+    _start_msecs(0)
+  {}
+
+  trajectory_writer::~trajectory_writer() {
+    close();
+  }
+
+  QString trajectory_writer::default_path() {
+    static QAtomicInt sequence(0);
+    const int seq = sequence.fetchAndAddRelaxed(1);
+
+    const QString dir = settings_store::instance().directory() + "/trajectories";
+    QDir().mkpath(dir);
+
+    // Make room for the new file, oldest first
+    const QFileInfoList files = QDir(dir).entryInfoList(QStringList() << "*.rmtraj", QDir::Files, QDir::Time);
+    for (int i = kept_files - 1; i < files.size(); ++i)
+      QFile::remove(files[i].absoluteFilePath());
+
+    QString name = QString("scan_%1_%2")
+      .arg(QDateTime::currentDateTime().toString("yyyyMMdd-hhmmss-zzz"))
+      .arg(QCoreApplication::applicationPid());
+    if (seq > 0)
+      name += QString("-%1").arg(seq);
+    return dir + "/" + name + ".rmtraj";
+  }
+
+  bool trajectory_writer::open(const QString &path) {
+    close();
+
+    _file.setFileName(path);
+    if (!_file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+      return false;
+
+    _start_msecs = QDateTime::currentMSecsSinceEpoch();
+    _clock.start();
+    _file.write(trajectory::encode_header(_start_msecs));
+
+    {
+      QMutexLocker lock(&_mutex);
+      _samples.clear();
+    }
+    _head = 0;
+    _tail = 0;
+    _dropped = 0;
+    _stop = 0;
+    start(QThread::LowPriority);
+    return true;
+  }
+
+  void trajectory_writer::close() {
+    _stop.fetchAndStoreOrdered(1);
+    if (isRunning())
+      wait();
+    if (_file.isOpen())
+      _file.close();
+  }
+
+  bool trajectory_writer::is_open() const {
+    return _file.isOpen();
+  }
+
+  bool trajectory_writer::push(const trajectory_sample &s) {
+    const int head = _head;
+    if (head - _tail.fetchAndAddAcquire(0) >= ring_capacity) {
+      _dropped.fetchAndAddRelaxed(1);
+      return false;
+    }
+    _ring[head & (ring_capacity - 1)] = s;
+    _head.fetchAndStoreRelease(head + 1);
+    return true;
+  }
+
+  void trajectory_writer::sync() {
+    while (isRunning() && _tail.fetchAndAddAcquire(0) != _head)
+      msleep(1);
+  }
+
+  QVector<trajectory_sample> trajectory_writer::samples() const {
+    QMutexLocker lock(&_mutex);
+    return _samples;
+  }
+
+  int trajectory_writer::num_dropped() const {
+    return _dropped;
+  }
+
+  qint64 trajectory_writer::start_msecs() const {
+    return _start_msecs;
+  }
+
+  qint64 trajectory_writer::now_us() const {
+    return _clock.nsecsElapsed() / 1000;
+  }
+
+  void trajectory_writer::run() {
+    while (_stop == 0) {
+      if (!drain())
+        msleep(poll_msecs);
+    }
+    drain();
+    _file.flush();
+  }
+
+  bool trajectory_writer::drain() {
+    const int tail = _tail;
+    const int head = _head.fetchAndAddAcquire(0);
+    if (tail == head)
+      return false;
+
+    QByteArray records((head - tail) * trajectory::record_size, 0);
+    {
+      QMutexLocker lock(&_mutex);
+      for (int i = tail; i != head; ++i) {
+        const trajectory_sample &s = _ring.at(i & (ring_capacity - 1));
+        trajectory::encode(s, records.data() + (i - tail) * trajectory::record_size);
+        _samples.push_back(s);
+      }
+    }
+    _tail.fetchAndStoreRelease(head);
+
+    _file.write(records);
+    _file.flush();
+    return true;
+  }
+}
@@ -0,0 +1,213 @@
+#pragma once
+
+#include <QElapsedTimer>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QFile>
+#include <QTextStream>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <iostream>
+
+#if _WIN32
+  #define WIN32_LEAN_AND_MEAN
+  #include <windows.h>
+  #include <psapi.h>
+#else
+  #include <cstdio>
+  #include <cstring>
+#endif
+
+namespace bench {
+
+  /** Peak resident set size of this process in megabytes */
+  inline double peak_rss_mb() {
+#if _WIN32
+    PROCESS_MEMORY_COUNTERS pmc;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc)))
+      return 0;
+    return pmc.PeakWorkingSetSize / (1024.0 * 1024.0);
+#else
+    FILE *f = fopen("/proc/self/status", "r");
+    if (!f)
+      return 0;
+    char line[256];
+    long kb = 0;
+    while (fgets(line, sizeof(line), f)) {
+      if (strncmp(line, "VmHWM:", 6) == 0) {
+        sscanf(line + 6, "%ld", &kb);
+        break;
+      }
+    }
+    fclose(f);
+    return kb / 1024.0;
+#endif
+  }
+
+  /** Summary statistics of one benchmark in milliseconds per iteration */
+  struct result {
+    QString name;
+    int samples;
+    double items;
+    double min_ms, median_ms, mean_ms, p95_ms, stddev_ms;
+
+    double items_per_sec() const { 
+      return median_ms > 0 ? items / (median_ms / 1000.0) : 0;
+    }
+  };
+
+  /** Command line of the benchmark executable.
+   *
+   *  --samples N     timed iterations per benchmark (default 20)
+   *  --warmup N      untimed iterations per benchmark (default 3)
+   *  --filter TEXT   run only benchmarks whose name contains TEXT
+   *  --json FILE     write results as JSON
+   *  --csv FILE      write results as CSV
+   */
+  struct options {
+    int samples;
+    int warmup;
+    QString filter;
+    QString json;
+    QString csv;
+
+    options() : samples(20), warmup(3) {}
+
+    static options parse(const QStringList &args) {
+      options o;
+      for (int i = 1; i + 1 < args.size(); ++i) {
+        if (args[i] == "--samples") o.samples = std::max(1, args[++i].toInt());
+        else if (args[i] == "--warmup") o.warmup = std::max(0, args[++i].toInt());
+        else if (args[i] == "--filter") o.filter = args[++i];
+        else if (args[i] == "--json") o.json = args[++i];
+        else if (args[i] == "--csv") o.csv = args[++i];
+      }
+      return o;
+    }
+  };
+
+  /** Runs benchmarks, collects and reports their results.
+   *
+   *  A benchmark is a callable timed as a whole per iteration. An optional 
+   *  setup callable runs untimed before each iteration. Large fixtures may
+   *  scale down the number of samples through sample_divisor.
+   */
+  class runner {
+  public:
+    explicit runner(const options &o) : _o(o) {}
+
+    bool enabled(const QString &name) const {
+      return _o.filter.isEmpty() || name.contains(_o.filter);
+    }
+
+    void run(const QString &name, double items, 
+             const std::function<void()> &fn, 
+             const std::function<void()> &setup = std::function<void()>(),
+             int sample_divisor = 1)
+    {
+      if (!enabled(name))
+        return;
+
+      const int samples = std::max(3, _o.samples / sample_divisor);
+      const int warmup = std::min(_o.warmup, samples);
+
+      for (int i = 0; i < warmup; ++i) {
+        if (setup) setup();
+        fn();
+      }
+
+      QVector<double> ms;
+      ms.reserve(samples);
+      QElapsedTimer t;
+      for (int i = 0; i < samples; ++i) {
+        if (setup) setup();
+        t.start();
+        fn();
+        ms.push_back(t.nsecsElapsed() / 1e6);
+      }
+
+      result r = summarize(name, items, ms);
+      _results.push_back(r);
+
+      std::cout << qPrintable(name.leftJustified(40)) 
+                << " median " << r.median_ms << " ms"
+                << ", p95 " << r.p95_ms << " ms"
+                << ", " << r.items_per_sec() << " items/s" << std::endl;
+    }
+
+    const QVector<result> &results() const { return _results; }
+
+    /** Writes results to the files given on the command line */
+    bool write() const {
+      bool ok = true;
+      if (!_o.json.isEmpty()) ok &= write_json(_o.json);
+      if (!_o.csv.isEmpty()) ok &= write_csv(_o.csv);
+      return ok;
+    }
+
+    static result summarize(const QString &name, double items, QVector<double> ms) {
+      std::sort(ms.begin(), ms.end());
+      const int n = ms.size();
+
+      result r;
+      r.name = name;
+      r.samples = n;
+      r.items = items;
+      r.min_ms = ms.front();
+      r.median_ms = ms[n / 2];
+      r.p95_ms = ms[std::min(n - 1, (int)std::ceil(0.95 * n) - 1)];
+
+      double sum = 0, sq = 0;
+      for (int i = 0; i < n; ++i) sum += ms[i];
+      r.mean_ms = sum / n;
+      for (int i = 0; i < n; ++i) sq += (ms[i] - r.mean_ms) * (ms[i] - r.mean_ms);
+      r.stddev_ms = n > 1 ? std::sqrt(sq / (n - 1)) : 0;
+      return r;
+    }
+
+  private:
+    bool write_json(const QString &path) const {
+      QFile f(path);
+      if (!f.open(QIODevice::WriteOnly | QIODevice::Text))
+        return false;
+      QTextStream ts(&f);
+      ts << "{\n  \"benchmarks\": [\n";
+      for (int i = 0; i < _results.size(); ++i) {
+        const result &r = _results[i];
+        ts << "    {\"name\": \"" << r.name << "\""
+           << ", \"samples\": " << r.samples
+           << ", \"items\": " << r.items
+           << ", \"min_ms\": " << r.min_ms
+           << ", \"median_ms\": " << r.median_ms
+           << ", \"mean_ms\": " << r.mean_ms
+           << ", \"p95_ms\": " << r.p95_ms
+           << ", \"stddev_ms\": " << r.stddev_ms
+           << ", \"items_per_sec\": " << r.items_per_sec() << "}"
+           << (i + 1 < _results.size() ? ",\n" : "\n");
+      }
+      ts << "  ]\n}\n";
+      return true;
+    }
+
+    bool write_csv(const QString &path) const {
+      QFile f(path);
+      if (!f.open(QIODevice::WriteOnly | QIODevice::Text))
+        return false;
+      QTextStream ts(&f);
+      ts << "name,samples,items,min_ms,median_ms,mean_ms,p95_ms,stddev_ms,items_per_sec\n";
+      for (int i = 0; i < _results.size(); ++i) {
+        const result &r = _results[i];
+        ts << r.name << "," << r.samples << "," << r.items << "," 
+           << r.min_ms << "," << r.median_ms << "," << r.mean_ms << "," 
+           << r.p95_ms << "," << r.stddev_ms << "," << r.items_per_sec() << "\n";
+      }
+      return true;
+    }
+
+    options _o;
+    QVector<result> _results;
+  };
+}
@@ -0,0 +1,203 @@
+#include "bench_harness.h"
+
+#include "qglcanvas.h"
+#include "surface_geometry.h"
+#include "log_model.h"
+
+#include "surface.pb.h"
+
+#include <QApplication>
+#include <QDir>
+#include <QSettings>
+#include <QTableView>
+
+#include <memory>
+#include <vector>
+
+using namespace ReconstructMeGUI;
+
+/** Regular grid mesh in the layout returned by reme_surface_get_points/faces */
+struct grid_mesh {
+  std::vector<float> points;
+  std::vector<float> normals;
+  std::vector<unsigned> faces;
+
+  explicit grid_mesh(int num_faces) {
+    const int cols = std::max(1, (int)std::sqrt(num_faces / 2.0));
+    const int rows = std::max(1, num_faces / (2 * cols));
+    const int w = cols + 1;
+
+    points.reserve((rows + 1) * w * 4);
+    normals.reserve((rows + 1) * w * 4);
+    for (int y = 0; y <= rows; ++y) {
+      for (int x = 0; x <= cols; ++x) {
+        const float p[4] = {(float)x, (float)y, std::sin(x * 0.1f) * std::cos(y * 0.1f), 1.f};
+        const float n[4] = {0.f, 0.f, 1.f, 0.f};
+        points.insert(points.end(), p, p + 4);
+        normals.insert(normals.end(), n, n + 4);
+      }
+    }
+
+    faces.reserve(rows * cols * 6);
+    for (int y = 0; y < rows; ++y) {
+      for (int x = 0; x < cols; ++x) {
+        const unsigned i = y * w + x;
+        const unsigned f[6] = {i, i + 1, i + w, i + 1, i + w + 1, i + w};
+        faces.insert(faces.end(), f, f + 6);
+      }
+    }
+  }
+
+  int num_points() const { return (int)points.size() / 4; }
+  int num_faces() const { return (int)faces.size() / 3; }
+};
+
+static void bench_canvas(bench::runner &r) {
+  static const int res[][2] = {{320, 240}, {640, 480}, {1280, 720}, {1920, 1080}};
+
+  QGLCanvas canvas;
+  canvas.resize(640, 480);
+  canvas.show();
+  QApplication::processEvents();
+
+  for (int i = 0; i < 4; ++i) {
+    const int w = res[i][0], h = res[i][1];
+    const QString name = QString("canvas_set_image/%1x%2").arg(w).arg(h);
+    if (!r.enabled(name))
+      continue;
+
+    QByteArray rgb(w * h * 3, 0);
+    for (int k = 0; k < rgb.size(); ++k)
+      rgb[k] = (char)(k * 7);
+
+    r.run(name, 1, [&]() {
+      canvas.set_image(w, h, rgb.constData(), rgb.size());
+    });
+  }
+}
+
+static void bench_surface_geometry(bench::runner &r) {
+  static const int sizes[] = {100000, 1000000, 10000000};
+  static const int divisors[] = {1, 4, 20};
+
+  for (int i = 0; i < 3; ++i) {
+    const QString name = QString("surface_geometry/%1").arg(sizes[i]);
+    if (!r.enabled(name))
+      continue;
+
+    grid_mesh m(sizes[i]);
+    r.run(name, m.num_faces(), [&]() {
+      osg::ref_ptr<osg::Geometry> g = create_surface_geometry(
+        &m.points[0], m.num_points(), &m.normals[0], &m.faces[0], m.num_faces());
+    }, std::function<void()>(), divisors[i]);
+  }
+}
+
+static void bench_options_serialization(bench::runner &r) {
+  const int n = 1000;
+  std::string msg;
+
+  r.run("options_serialize/generation", n, [&]() {
+    for (int i = 0; i < n; ++i) {
+      generation_options go;
+      go.set_merge_duplicate_vertices(true);
+      go.set_merge_radius(0.1f * (i % 10));
+      go.SerializeToString(&msg);
+    }
+  });
+
+  r.run("options_serialize/decimation", n, [&]() {
+    for (int i = 0; i < n; ++i) {
+      decimation_options deco;
+      deco.set_maximum_faces(100000 + i);
+      deco.SerializeToString(&msg);
+    }
+  });
+
+  // As in generate_surface, message and buffer are reused between calls
+  decimation_options reused;
+  r.run("options_serialize/decimation_reused", n, [&]() {
+    for (int i = 0; i < n; ++i) {
+      reused.set_maximum_faces(100000 + i);
+      reused.SerializeToString(&msg);
+    }
+  });
+}
+
+static void bench_log_insertion(bench::runner &r) {
+  static const int batches[] = {100, 1000, 100000};
+  
+  for (int i = 0; i < 3; ++i) {
+    const int n = batches[i];
+    const QString name = QString("log_insert/%1").arg(n);
+    if (!r.enabled(name))
+      continue;
+
+    log_model model;
+    QTableView view;
+    view.setModel(&model);
+    const QString msg("Volume update took 12 ms, tracking succeeded with 3 iterations");
+
+    r.run(name, n, [&]() {
+      for (int k = 0; k < n; ++k)
+        model.append(REME_LOG_SEVERITY_INFO, msg);
+      model.flush();
+    }, [&]() {
+      model.clear();
+    });
+  }
+}
+
+/** Messages of an indexed log held in memory */
+struct vector_source : public log_index::source {
+  QVector<QString> messages;
+  virtual QString message(qint64 seq) const { return messages[(int)seq]; }
+};
+
+static void bench_log_search(bench::runner &r) {
+  const int n = 1000000;
+  if (!r.enabled("log_search"))
+    return;
+
+  static const char *words[] = {"tracking", "lost", "volume", "update", "sensor", "frame", "camera", "surface"};
+  vector_source src;
+  log_index index;
+  src.messages.reserve(n);
+  for (int i = 0; i < n; ++i) {
+    const QString msg = QString("%1 %2 after %3 iterations").arg(words[i % 8]).arg(words[(i / 8) % 8]).arg(i % 97);
+    const reme_log_severity_t sev = (i % 50 == 0) ? REME_LOG_SEVERITY_ERROR : ((i % 10 == 0) ? REME_LOG_SEVERITY_WARNING : REME_LOG_SEVERITY_INFO);
+    src.messages.push_back(msg);
+    index.add(sev, 1000000 + i, msg);
+  }
+
+  log_index::query severity;
+  severity.severities = log_index::ERROR_MASK;
+  r.run("log_search/severity", n, [&]() { index.search(severity, src); });
+
+  log_index::query range;
+  range.from_msecs = 1000000 + n / 2;
+  range.to_msecs = 1000000 + n / 2 + 1000;
+  r.run("log_search/time_range", n, [&]() { index.search(range, src); });
+
+  log_index::query text;
+  text.text = "camera lost";
+  r.run("log_search/text", n, [&]() { index.search(text, src); });
+}
+
+int main(int argc, char *argv[])
+{
+  QApplication app(argc, argv);
+
+  // Keep settings and kernel cache of the benchmarks away from the user's
+  QSettings::setPath(QSettings::IniFormat, QSettings::UserScope, QDir::temp().absoluteFilePath("reme_bench"));
+
+  bench::runner r(bench::options::parse(app.arguments()));
+
+  bench_canvas(r);
+  bench_surface_geometry(r);
+  bench_options_serialization(r);
+  bench_log_insertion(r);
+  bench_log_search(r);
+
+  return r.write() ? 0 : 1;
+}
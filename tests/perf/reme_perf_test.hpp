@@ -0,0 +1,224 @@
+#include "reme_resource_manager.h"
+#include "frame_grabber.h"
+#include "kernel_cache.h"
+#include "surface_geometry.h"
+#include "settings.h"
+#include "reme_stub.h"
+
+#include "../bench/bench_harness.h"
+
+#include <QObject>
+#include <QtTest>
+#include <QtCore>
+#include <QElapsedTimer>
+#include <QSettings>
+#include <QDir>
+
+#include <memory>
+#include <iostream>
+
+using namespace ReconstructMeGUI;
+
+/** Scans a fixed number of frames, then generates a surface and converts it for display */
+class perf_driver : public QObject
+{
+  Q_OBJECT
+
+public:
+  perf_driver(std::shared_ptr<reme_resource_manager> rm, std::shared_ptr<frame_grabber> fg, int warmup_frames, int frames, int samples) :
+    _rm(rm), _fg(fg), _warmup_frames(warmup_frames), _frames(frames), _frame(0), _samples(samples), 
+    scan_msecs(0), num_faces(0)
+  {}
+
+  QVector<double> frame_ms;
+  double scan_msecs;
+  bench::result mesh_upload;
+  int num_faces;
+
+public slots:
+  void frame() {
+    if (_frame == 0) {
+      _rm->start_scanning();
+    } else if (_frame == _warmup_frames) {
+      _scan.start();
+      _last.start();
+    } else if (_frame > _warmup_frames) {
+      frame_ms.push_back(_last.nsecsElapsed() / 1e6);
+      _last.start();
+    }
+
+    if (++_frame < _warmup_frames + _frames + 1)
+      return;
+
+    scan_msecs = _scan.nsecsElapsed() / 1e6;
+    _rm->stop_scanning();
+    _rm->generate_surface(0.5f);
+    _fg->stop();
+  }
+
+  void surface(bool has_surface, const float *points, int num_points, const float *normals, int, const unsigned *faces, int faces_count) {
+    if (!has_surface)
+      return;
+    
+    num_faces = faces_count;
+
+    // Timed in place, buffers are only valid during this call
+    QVector<double> ms;
+    QElapsedTimer t;
+    for (int i = 0; i < _samples + 1; ++i) {
+      t.start();
+      osg::ref_ptr<osg::Geometry> g = create_surface_geometry(points, num_points, normals, faces, faces_count);
+      if (i > 0)
+        ms.push_back(t.nsecsElapsed() / 1e6);
+    }
+    mesh_upload = bench::runner::summarize("mesh_upload", faces_count, ms);
+  }
+
+private:
+  std::shared_ptr<reme_resource_manager> _rm;
+  std::shared_ptr<frame_grabber> _fg;
+  int _warmup_frames, _frames, _frame, _samples;
+  QElapsedTimer _scan, _last;
+};
+
+/** Compares a fixed workload against tests/perf/baseline.ini.
+ *
+ *  Fails when fps drops, or p95 frame time, mesh upload time or peak memory 
+ *  rise by more than the tolerance given in the baseline. Until the baseline 
+ *  is marked as measured the comparison is skipped and the test exits with 
+ *  skipped_exit_code, which CTest reports as skipped. Current numbers are 
+ *  written to REME_PERF_OUT (perf_current.ini by default) in baseline 
+ *  format. REME_PERF_BASELINE overrides the baseline file.
+ */
+class reme_perf_test : public QObject
+{
+  Q_OBJECT
+
+public:
+  enum { skipped_exit_code = 77 };
+
+  reme_perf_test() : _measured_baseline(true) {}
+  bool measured_baseline() const { return _measured_baseline; }
+
+private slots:
+  void regression();
+
+private:
+  void check(QSettings &baseline, const QString &metric, double current, bool higher_is_better, QStringList &failures);
+
+  bool _measured_baseline;
+};
+
+void reme_perf_test::check(QSettings &baseline, const QString &metric, double current, bool higher_is_better, QStringList &failures) 
+{
+  const double base = baseline.value("metrics/" + metric, 0).toDouble();
+  const double tolerance = baseline.value("tolerance/" + metric, 10).toDouble() / 100.0;
+
+  std::cout << qPrintable(metric.leftJustified(16)) << " current " << current << ", baseline " << base << std::endl;
+
+  if (base <= 0) {
+    QWARN(qPrintable("No baseline for " + metric));
+    return;
+  }
+
+  const bool regressed = higher_is_better ? 
+    current < base * (1.0 - tolerance) : 
+    current > base * (1.0 + tolerance);
+  
+  if (regressed)
+    failures << QString("%1 %2 vs baseline %3").arg(metric).arg(current).arg(base);
+}
+
+void reme_perf_test::regression()
+{
+  const QByteArray baseline_env = qgetenv("REME_PERF_BASELINE");
+  const QByteArray out_env = qgetenv("REME_PERF_OUT");
+  const QString baseline_path = baseline_env.isEmpty() ? QString("perf/baseline.ini") : QString(baseline_env);
+  const QString out_path = out_env.isEmpty() ? QString("perf_current.ini") : QString(out_env);
+
+  QVERIFY2(QFile::exists(baseline_path), qPrintable("Missing baseline " + baseline_path));
+
+  std::shared_ptr<reme_resource_manager> rm(new reme_resource_manager());
+  rm->override_setting(sensor_path_tag, "stub");
+  rm->override_setting(config_path_tag, config_path_default_tag);
+  rm->override_setting(license_file_tag, "stub.lic");
+
+  // Fixed workload independent of REME_STUB_* in the environment
+  reme_stub::config c;
+  c.depth_width = c.aux_width = 640;
+  c.depth_height = c.aux_height = 480;
+  c.mesh_faces = 200000;
+  c.lose_track_every = 0;
+  c.latency_us[reme_stub::GRAB] = 5000;
+  c.latency_us[reme_stub::TRACK] = 2000;
+  c.latency_us[reme_stub::UPDATE_VOLUME] = 3000;
+  reme_stub::set_config(c);
+
+  std::shared_ptr<frame_grabber> fg(new frame_grabber(rm));
+  rm->set_frame_grabber(fg);
+  fg->request(REME_IMAGE_AUX);
+  fg->request(REME_IMAGE_DEPTH);
+  fg->request(REME_IMAGE_VOLUME);
+
+  perf_driver driver(rm, fg, 20, 300, 5);
+  driver.connect(fg.get(), SIGNAL(frames_updated()), SLOT(frame()));
+  driver.connect(rm.get(), SIGNAL(surface(bool, const float *, int, const float *, int, const unsigned *, int)), SLOT(surface(bool, const float *, int, const float *, int, const unsigned *, int)));
+
+  rm->initialize();
+
+  QVERIFY(driver.num_faces > 0);
+  QVERIFY(!driver.frame_ms.isEmpty());
+
+  const bench::result frames = bench::runner::summarize("frame", 1, driver.frame_ms);
+  const double fps = driver.frame_ms.size() / (driver.scan_msecs / 1000.0);
+  const double p95_frame_ms = frames.p95_ms;
+  const double mesh_upload_ms = driver.mesh_upload.median_ms;
+  const double peak_rss_mb = bench::peak_rss_mb();
+
+  QSettings baseline(baseline_path, QSettings::IniFormat);
+
+  {
+    QFile::remove(out_path);
+    QSettings current(out_path, QSettings::IniFormat);
+    current.setValue("baseline/measured", true);
+    current.setValue("metrics/fps", fps);
+    current.setValue("metrics/p95_frame_ms", p95_frame_ms);
+    current.setValue("metrics/mesh_upload_ms", mesh_upload_ms);
+    current.setValue("metrics/peak_rss_mb", peak_rss_mb);
+    current.beginGroup("tolerance");
+    baseline.beginGroup("tolerance");
+    foreach (const QString &k, baseline.childKeys())
+      current.setValue(k, baseline.value(k));
+    baseline.endGroup();
+    current.endGroup();
+  }
+
+  QStringList failures;
+  check(baseline, "fps", fps, true, failures);
+  check(baseline, "p95_frame_ms", p95_frame_ms, false, failures);
+  check(baseline, "mesh_upload_ms", mesh_upload_ms, false, failures);
+  check(baseline, "peak_rss_mb", peak_rss_mb, false, failures);
+
+  if (!baseline.value("baseline/measured", false).toBool()) {
+    _measured_baseline = false;
+    std::cout << "Baseline " << qPrintable(baseline_path) << " is not measured, record one from " << qPrintable(out_path) << std::endl;
+    if (!failures.isEmpty())
+      std::cout << "Regressions against the placeholder: " << qPrintable(failures.join("; ")) << std::endl;
+    QSKIP("No measured performance baseline, regression gate skipped", SkipAll);
+  }
+
+  QVERIFY2(failures.isEmpty(), qPrintable("Performance regressed: " + failures.join("; ")));
+}
+
+int main(int argc, char *argv[])
+{
+  QCoreApplication app(argc, argv);
+  
+  // Keep settings and kernel cache of the test away from the user's
+  QSettings::setPath(QSettings::IniFormat, QSettings::UserScope, QDir::temp().absoluteFilePath("reme_perf"));
+  kernel_cache(kernel_cache::default_root()).export_environment();
+
+  reme_perf_test t;
+  const int result = QTest::qExec(&t, argc, argv);
+  return result == 0 && !t.measured_baseline() ? reme_perf_test::skipped_exit_code : result;
+}
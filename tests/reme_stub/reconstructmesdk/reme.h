@@ -0,0 +1,86 @@
+// Stand-in for the ReconstructMe SDK C API, covering the functions called by
+// ReconstructMeQt. Implemented in reme_stub.cpp.
+
+#pragma once
+
+#include "types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Context
+reme_error_t reme_context_create(reme_context_t *c);
+reme_error_t reme_context_destroy(reme_context_t *c);
+reme_error_t reme_context_compile(reme_context_t c);
+reme_error_t reme_context_get_version(reme_context_t c, const char **version, int *length);
+reme_error_t reme_context_set_log_callback(reme_context_t c, reme_log_callback_t f, void *user_data);
+reme_error_t reme_context_bind_reconstruction_options(reme_context_t c, reme_options_t o);
+reme_error_t reme_context_bind_opencl_info(reme_context_t c, reme_options_t o);
+
+// Options
+reme_error_t reme_options_create(reme_context_t c, reme_options_t *o);
+reme_error_t reme_options_destroy(reme_context_t c, reme_options_t *o);
+reme_error_t reme_options_set(reme_context_t c, reme_options_t o, const char *field_name, const char *value);
+reme_error_t reme_options_get_int(reme_context_t c, reme_options_t o, const char *field_name, int *value);
+reme_error_t reme_options_get_bool(reme_context_t c, reme_options_t o, const char *field_name, bool *value);
+reme_error_t reme_options_set_bytes(reme_context_t c, reme_options_t o, const void *bytes, int length);
+reme_error_t reme_options_get_bytes(reme_context_t c, reme_options_t o, const void **bytes, int *length);
+reme_error_t reme_options_load_from_file(reme_context_t c, reme_options_t o, const char *filename);
+
+// License
+reme_error_t reme_license_create(reme_context_t c, reme_license_t *l);
+reme_error_t reme_license_destroy(reme_context_t c, reme_license_t *l);
+reme_error_t reme_license_authenticate(reme_context_t c, reme_license_t l, const char *license_file);
+reme_error_t reme_license_bind_hardware_hashes(reme_context_t c, reme_license_t l, reme_options_t o);
+
+// Sensor
+reme_error_t reme_sensor_create(reme_context_t c, const char *driver, bool require_can_open, reme_sensor_t *s);
+reme_error_t reme_sensor_destroy(reme_context_t c, reme_sensor_t *s);
+reme_error_t reme_sensor_open(reme_context_t c, reme_sensor_t s);
+reme_error_t reme_sensor_bind_capture_options(reme_context_t c, reme_sensor_t s, reme_options_t o);
+reme_error_t reme_sensor_is_image_supported(reme_context_t c, reme_sensor_t s, reme_sensor_image_t it, bool *result);
+reme_error_t reme_sensor_grab(reme_context_t c, reme_sensor_t s);
+reme_error_t reme_sensor_prepare_image(reme_context_t c, reme_sensor_t s, reme_sensor_image_t it);
+reme_error_t reme_sensor_get_image(reme_context_t c, reme_sensor_t s, reme_sensor_image_t it, reme_image_t i);
+reme_error_t reme_sensor_track_position(reme_context_t c, reme_sensor_t s);
+reme_error_t reme_sensor_get_position(reme_context_t c, reme_sensor_t s, float *coordinates);
+reme_error_t reme_sensor_update_volume(reme_context_t c, reme_sensor_t s);
+reme_error_t reme_sensor_set_trackhint(reme_context_t c, reme_sensor_t s, reme_sensor_trackhint_t hint);
+reme_error_t reme_sensor_reset(reme_context_t c, reme_sensor_t s);
+
+// Image
+reme_error_t reme_image_create(reme_context_t c, reme_image_t *i);
+reme_error_t reme_image_destroy(reme_context_t c, reme_image_t *i);
+reme_error_t reme_image_get_bytes(reme_context_t c, reme_image_t i, const void **bytes, int *length);
+reme_error_t reme_image_get_mutable_bytes(reme_context_t c, reme_image_t i, void **bytes, int *length);
+reme_error_t reme_image_get_info(reme_context_t c, reme_image_t i, int *width, int *height, int *num_channels, int *num_bytes_per_channel, int *row_stride);
+
+// Volume
+reme_error_t reme_volume_create(reme_context_t c, reme_volume_t *v);
+reme_error_t reme_volume_destroy(reme_context_t c, reme_volume_t *v);
+reme_error_t reme_volume_reset(reme_context_t c, reme_volume_t v);
+
+// Surface
+reme_error_t reme_surface_create(reme_context_t c, reme_surface_t *s);
+reme_error_t reme_surface_destroy(reme_context_t c, reme_surface_t *s);
+reme_error_t reme_surface_bind_generation_options(reme_context_t c, reme_surface_t s, reme_options_t o);
+reme_error_t reme_surface_bind_decimation_options(reme_context_t c, reme_surface_t s, reme_options_t o);
+reme_error_t reme_surface_generate(reme_context_t c, reme_surface_t s, reme_volume_t v);
+reme_error_t reme_surface_decimate(reme_context_t c, reme_surface_t s);
+reme_error_t reme_surface_get_points(reme_context_t c, reme_surface_t s, const float **coordinates, int *length);
+reme_error_t reme_surface_get_normals(reme_context_t c, reme_surface_t s, const float **coordinates, int *length);
+reme_error_t reme_surface_get_triangles(reme_context_t c, reme_surface_t s, const unsigned **indices, int *length);
+reme_error_t reme_surface_transform(reme_context_t c, reme_surface_t s, const float *transform);
+reme_error_t reme_surface_save_to_file(reme_context_t c, reme_surface_t s, const char *filename);
+
+// Calibration
+reme_error_t reme_calibrator_create(reme_context_t c, reme_calibrator_t *cb);
+reme_error_t reme_calibrator_destroy(reme_context_t c, reme_calibrator_t *cb);
+
+// Transform
+reme_error_t reme_transform_set_predefined(reme_context_t c, reme_transform_t t, float *mat);
+
+#ifdef __cplusplus
+}
+#endif
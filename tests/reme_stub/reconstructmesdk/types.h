@@ -0,0 +1,56 @@
+// Stand-in for the ReconstructMe SDK types, covering the subset used by 
+// ReconstructMeQt. Handles and enumerators mirror the SDK so the application
+// compiles unchanged against reme_stub.
+
+#pragma once
+
+#define REME_VERSION_MAJOR 0
+#define REME_VERSION_MINOR 0
+#define REME_VERSION_BUILD 0
+#define REME_VERSION_REVISION 0
+
+#define REME_SUCCESS(x) ((x) == REME_ERROR_SUCCESS)
+
+typedef struct _reme_context* reme_context_t;
+
+typedef int reme_options_t;
+typedef int reme_sensor_t;
+typedef int reme_volume_t;
+typedef int reme_surface_t;
+typedef int reme_image_t;
+typedef int reme_license_t;
+typedef int reme_calibrator_t;
+
+typedef enum _reme_error_t {
+  REME_ERROR_SUCCESS = 0,
+  REME_ERROR_UNSPECIFIED = -1,
+  REME_ERROR_INVALID_LICENSE = -2,
+  REME_ERROR_TRACK_LOST = -3,
+  REME_ERROR_FILE_ERROR = -4,
+  REME_ERROR_INVALID_HANDLE = -5
+} reme_error_t;
+
+typedef enum _reme_sensor_image_t {
+  REME_IMAGE_AUX = 0,
+  REME_IMAGE_DEPTH = 1,
+  REME_IMAGE_VOLUME = 2,
+  REME_IMAGE_RAW_AUX = 3,
+  REME_IMAGE_RAW_DEPTH = 4
+} reme_sensor_image_t;
+
+typedef enum _reme_log_severity_t {
+  REME_LOG_SEVERITY_INFO = 0,
+  REME_LOG_SEVERITY_WARNING = 1,
+  REME_LOG_SEVERITY_ERROR = 2
+} reme_log_severity_t;
+
+typedef enum _reme_sensor_trackhint_t {
+  REME_SENSOR_TRACKHINT_NONE = 0,
+  REME_SENSOR_TRACKHINT_USE_GLOBAL = 1
+} reme_sensor_trackhint_t;
+
+typedef enum _reme_transform_t {
+  REME_TRANSFORM_WORLD_TO_CAD = 0
+} reme_transform_t;
+
+typedef void (*reme_log_callback_t)(reme_log_severity_t sev, const char *message, void *user_data);
@@ -0,0 +1,837 @@
+// In-process implementation of the ReconstructMe SDK subset used by 
+// ReconstructMeQt. Objects live in per-context tables so that leaks show up
+// in the counters exposed by reme_stub.h. Frames and meshes are synthetic 
+// and deterministic, call latencies are configurable.
+
+#include "reconstructmesdk/reme.h"
+#include "reme_stub.h"
+
+#include <QMutex>
+#include <QMutexLocker>
+#include <QAtomicInt>
+#include <QElapsedTimer>
+#include <QByteArray>
+#include <QString>
+#include <QStringList>
+
+#include <map>
+#include <string>
+#include <vector>
+#include <sstream>
+#include <fstream>
+#include <cstring>
+#include <cstdlib>
+#include <cstdio>
+#include <cmath>
+#include <algorithm>
+
+#if _WIN32
+  #define WIN32_LEAN_AND_MEAN
+  #include <windows.h>
+#else
+  #include <unistd.h>
+#endif
+
+namespace reme_stub {
+  config::config() : 
+    depth_width(640), depth_height(480), aux_width(640), aux_height(480), 
+    mesh_faces(20000), lose_track_every(0) 
+  {
+    for (int i = 0; i < NUM_CALLS; ++i)
+      latency_us[i] = 0;
+  }
+}
+
+namespace {
+  
+  QAtomicInt g_live_contexts;
+  QAtomicInt g_live_objects;
+  QAtomicInt g_created_objects;
+  QAtomicInt g_num_calls[reme_stub::NUM_CALLS];
+
+  QMutex g_config_mutex;
+  reme_stub::config g_config;
+  bool g_config_loaded = false;
+
+  reme_stub::config current_config() {
+    QMutexLocker lock(&g_config_mutex);
+    return g_config;
+  }
+
+  /** Sleeps for coarse delays and spins for the remainder */
+  void delay(int us) {
+    if (us <= 0)
+      return;
+    QElapsedTimer t;
+    t.start();
+    if (us > 2000) {
+#if _WIN32
+      Sleep((us - 1000) / 1000);
+#else
+      usleep(us - 1000);
+#endif
+    }
+    while (t.nsecsElapsed() < us * 1000LL) {}
+  }
+
+  /** Counts call and applies its configured latency, never while holding a context lock */
+  void simulate(reme_stub::call_t call) {
+    g_num_calls[call].ref();
+    delay(current_config().latency_us[call]);
+  }
+
+  enum kind_t { OPTIONS, SENSOR, VOLUME, SURFACE, IMAGE, LICENSE, CALIBRATOR };
+
+  enum binding_t { UNBOUND, RECONSTRUCTION, OPENCL_INFO, CAPTURE, GENERATION, DECIMATION, HARDWARE_HASHES };
+
+  typedef std::map<std::string, std::string> values_t;
+
+  struct object {
+    object() : kind(OPTIONS), binding(UNBOUND), target(0), open(false), frame(0), 
+      width(0), height(0), channels(0), bytes_per_channel(0), max_faces(0) {}
+
+    kind_t kind;
+
+    // options
+    binding_t binding;
+    int target;
+    values_t values;
+    std::string bytes;
+
+    // sensor
+    std::string driver;
+    bool open;
+    int frame;
+
+    // image
+    int width, height, channels, bytes_per_channel;
+    std::vector<char> data;
+
+    // surface
+    std::vector<float> points, normals;
+    std::vector<unsigned> faces;
+    int max_faces;
+  };
+}
+
+struct _reme_context {
+  _reme_context() : next_handle(1), log(0), log_user_data(0) {
+    reconstruction["volume.resolution.x"] = "256";
+    reconstruction["volume.resolution.y"] = "256";
+    reconstruction["volume.resolution.z"] = "256";
+    reconstruction["volume.minimum_corner.x"] = "-500";
+    reconstruction["volume.minimum_corner.y"] = "-500";
+    reconstruction["volume.minimum_corner.z"] = "-500";
+    reconstruction["volume.maximum_corner.x"] = "500";
+    reconstruction["volume.maximum_corner.y"] = "500";
+    reconstruction["volume.maximum_corner.z"] = "500";
+    reconstruction["device_id"] = "-1";
+  }
+
+  QMutex m;
+  int next_handle;
+  std::map<int, object> objects;
+  values_t reconstruction;
+  reme_log_callback_t log;
+  void *log_user_data;
+};
+
+namespace {
+
+  const char *version_string = "reme_stub-0.0.0";
+
+  object *find(reme_context_t c, int h, kind_t kind) {
+    std::map<int, object>::iterator i = c->objects.find(h);
+    if (i == c->objects.end() || i->second.kind != kind)
+      return 0;
+    return &i->second;
+  }
+
+  reme_error_t create(reme_context_t c, kind_t kind, int *h) {
+    if (!c || !h)
+      return REME_ERROR_INVALID_HANDLE;
+    QMutexLocker lock(&c->m);
+    *h = c->next_handle++;
+    c->objects[*h].kind = kind;
+    g_live_objects.ref();
+    g_created_objects.ref();
+    return REME_ERROR_SUCCESS;
+  }
+
+  reme_error_t destroy(reme_context_t c, kind_t kind, int *h) {
+    if (!c || !h)
+      return REME_ERROR_INVALID_HANDLE;
+    QMutexLocker lock(&c->m);
+    if (!find(c, *h, kind))
+      return REME_ERROR_INVALID_HANDLE;
+    c->objects.erase(*h);
+    g_live_objects.deref();
+    return REME_ERROR_SUCCESS;
+  }
+
+  reme_error_t bind(reme_context_t c, reme_options_t o, binding_t binding, int target) {
+    if (!c)
+      return REME_ERROR_INVALID_HANDLE;
+    QMutexLocker lock(&c->m);
+    object *opt = find(c, o, OPTIONS);
+    if (!opt)
+      return REME_ERROR_INVALID_HANDLE;
+    opt->binding = binding;
+    opt->target = target;
+    opt->values.clear();
+    opt->bytes.clear();
+    return REME_ERROR_SUCCESS;
+  }
+
+  /** Values an options binding reads from and writes to */
+  values_t *bound_values(reme_context_t c, object *opt) {
+    switch (opt->binding) {
+      case RECONSTRUCTION: 
+        return &c->reconstruction;
+      case CAPTURE: {
+        object *s = find(c, opt->target, SENSOR);
+        return s ? &s->values : 0;
+      }
+      default:
+        return &opt->values;
+    }
+  }
+
+  std::string to_string(int v) {
+    std::stringstream ss;
+    ss << v;
+    return ss.str();
+  }
+
+  void sensor_defaults(object &s) {
+    const reme_stub::config cfg = current_config();
+    s.values["frame_info.supports_aux"] = "true";
+    s.values["frame_info.supports_depth"] = "true";
+    s.values["frame_info.aux_size.width"] = to_string(cfg.aux_width);
+    s.values["frame_info.aux_size.height"] = to_string(cfg.aux_height);
+    s.values["frame_info.depth_size.width"] = to_string(cfg.depth_width);
+    s.values["frame_info.depth_size.height"] = to_string(cfg.depth_height);
+  }
+
+  int to_int(const values_t &v, const char *key, int fallback) {
+    values_t::const_iterator i = v.find(key);
+    return i == v.end() ? fallback : atoi(i->second.c_str());
+  }
+
+  /** Depth in millimeters of a sphere orbiting in front of a back wall */
+  unsigned short synthetic_depth(int x, int y, int w, int h, int frame) {
+    const float angle = frame * 0.05f;
+    const float cx = w * (0.5f + 0.2f * cos(angle));
+    const float cy = h * (0.5f + 0.2f * sin(angle));
+    const float r = h * 0.25f;
+    const float dx = x - cx, dy = y - cy;
+    const float d2 = dx * dx + dy * dy;
+    if (d2 >= r * r)
+      return 1500;
+    return (unsigned short)(900 - 300 * sqrt(1.f - d2 / (r * r)));
+  }
+
+  void fill_image(object &img, const object &sensor, reme_sensor_image_t it) {
+    const bool depth = (it == REME_IMAGE_RAW_DEPTH);
+    const bool aux = (it == REME_IMAGE_AUX || it == REME_IMAGE_RAW_AUX);
+    img.width = to_int(sensor.values, aux ? "frame_info.aux_size.width" : "frame_info.depth_size.width", 640);
+    img.height = to_int(sensor.values, aux ? "frame_info.aux_size.height" : "frame_info.depth_size.height", 480);
+    img.channels = depth ? 1 : 3;
+    img.bytes_per_channel = depth ? 2 : 1;
+    
+    const size_t size = (size_t)img.width * img.height * img.channels * img.bytes_per_channel;
+    if (img.data.size() != size)
+      img.data.assign(size, 0);
+
+    // External sensors receive raw depth from the application
+    if (depth && sensor.driver == "external")
+      return;
+
+    const int w = img.width, h = img.height;
+    if (depth) {
+      unsigned short *d = (unsigned short*)&img.data[0];
+      for (int y = 0; y < h; ++y)
+        for (int x = 0; x < w; ++x)
+          *d++ = synthetic_depth(x, y, w, h, sensor.frame);
+    } else if (aux) {
+      // Colour gradient with a stripe moving across the image
+      unsigned char *p = (unsigned char*)&img.data[0];
+      const int stripe = (sensor.frame * 8) % w;
+      for (int y = 0; y < h; ++y) {
+        for (int x = 0; x < w; ++x) {
+          const bool on_stripe = std::abs(x - stripe) < 8;
+          *p++ = on_stripe ? 255 : (unsigned char)(255 * x / w);
+          *p++ = on_stripe ? 255 : (unsigned char)(255 * y / h);
+          *p++ = 128;
+        }
+      }
+    } else {
+      // Rendered depth and volume views, grey levels by distance
+      unsigned char *p = (unsigned char*)&img.data[0];
+      const int shift = (it == REME_IMAGE_VOLUME) ? 1 : 0;
+      for (int y = 0; y < h; ++y) {
+        for (int x = 0; x < w; ++x) {
+          const unsigned short z = synthetic_depth(x, y, w, h, sensor.frame - shift);
+          const unsigned char g = (unsigned char)(255 - std::min(255, (z - 600) / 4));
+          *p++ = g; *p++ = g; *p++ = g;
+        }
+      }
+    }
+  }
+
+  /** UV sphere of roughly num_faces triangles with outward normals */
+  void generate_mesh(object &s, int num_faces) {
+    const int rings = std::max(2, (int)sqrt(num_faces / 4.0));
+    const int segments = std::max(3, num_faces / (2 * rings));
+    const float radius = 150.f;
+    const float pi = 3.14159265f;
+
+    s.points.clear();
+    s.normals.clear();
+    s.faces.clear();
+    s.points.reserve((rings + 1) * (segments + 1) * 4);
+    s.normals.reserve((rings + 1) * (segments + 1) * 4);
+    s.faces.reserve(rings * segments * 6);
+
+    for (int r = 0; r <= rings; ++r) {
+      const float theta = pi * r / rings;
+      for (int k = 0; k <= segments; ++k) {
+        const float phi = 2 * pi * k / segments;
+        const float n[4] = { std::sin(theta) * std::cos(phi), std::sin(theta) * std::sin(phi), std::cos(theta), 0.f };
+        const float p[4] = { radius * n[0], radius * n[1], radius * n[2], 1.f };
+        s.points.insert(s.points.end(), p, p + 4);
+        s.normals.insert(s.normals.end(), n, n + 4);
+      }
+    }
+    for (int r = 0; r < rings; ++r) {
+      for (int k = 0; k < segments; ++k) {
+        const unsigned i = r * (segments + 1) + k;
+        const unsigned j = i + segments + 1;
+        const unsigned f[6] = { i, j, i + 1, i + 1, j, j + 1 };
+        s.faces.insert(s.faces.end(), f, f + 6);
+      }
+    }
+  }
+
+  /** Reads field 1 (varint) of a protobuf message, decimation_options.maximum_faces */
+  int read_field_1(const std::string &msg, int fallback) {
+    if (msg.size() < 2 || (unsigned char)msg[0] != 0x08)
+      return fallback;
+    int value = 0, shift = 0;
+    for (size_t i = 1; i < msg.size() && shift < 32; ++i, shift += 7) {
+      value |= ((unsigned char)msg[i] & 0x7F) << shift;
+      if (!((unsigned char)msg[i] & 0x80))
+        break;
+    }
+    return value;
+  }
+
+#define STUB_LOCK(c) if (!c) return REME_ERROR_INVALID_HANDLE; QMutexLocker lock(&c->m)
+}
+
+namespace reme_stub {
+  config get_config() { 
+    return current_config(); 
+  }
+
+  void set_config(const config &c) {
+    QMutexLocker lock(&g_config_mutex);
+    g_config = c;
+    g_config_loaded = true;
+  }
+
+  bool config_from_environment(config &c, std::string &error) {
+    static const char *call_names[NUM_CALLS] = { 
+      "compile", "open", "grab", "track", "update", "image", "generate", "decimate", "save" 
+    };
+
+    QByteArray v = qgetenv("REME_STUB_DEPTH_SIZE");
+    if (!v.isEmpty() && sscanf(v.constData(), "%dx%d", &c.depth_width, &c.depth_height) != 2) {
+      error = "REME_STUB_DEPTH_SIZE expects WIDTHxHEIGHT";
+      return false;
+    }
+    v = qgetenv("REME_STUB_AUX_SIZE");
+    if (!v.isEmpty() && sscanf(v.constData(), "%dx%d", &c.aux_width, &c.aux_height) != 2) {
+      error = "REME_STUB_AUX_SIZE expects WIDTHxHEIGHT";
+      return false;
+    }
+    v = qgetenv("REME_STUB_MESH_FACES");
+    if (!v.isEmpty())
+      c.mesh_faces = v.toInt();
+    v = qgetenv("REME_STUB_LOSE_TRACK_EVERY");
+    if (!v.isEmpty())
+      c.lose_track_every = v.toInt();
+
+    v = qgetenv("REME_STUB_LATENCY_US");
+    QStringList entries = QString(v).split(",", QString::SkipEmptyParts);
+    foreach(const QString &e, entries) {
+      QStringList kv = e.split("=");
+      bool known = false;
+      for (int i = 0; i < NUM_CALLS && kv.size() == 2; ++i) {
+        if (kv[0].trimmed() == call_names[i]) {
+          c.latency_us[i] = kv[1].toInt();
+          known = true;
+        }
+      }
+      if (!known) {
+        error = "REME_STUB_LATENCY_US: unknown entry " + e.toStdString();
+        return false;
+      }
+    }
+    return true;
+  }
+
+  int num_calls(call_t call) { return (int)g_num_calls[call]; }
+  int live_contexts() { return (int)g_live_contexts; }
+  int live_objects() { return (int)g_live_objects; }
+  int created_objects() { return (int)g_created_objects; }
+}
+
+extern "C" {
+
+  // ==================== context ====================
+
+  reme_error_t reme_context_create(reme_context_t *c) {
+    {
+      QMutexLocker lock(&g_config_mutex);
+      if (!g_config_loaded) {
+        std::string error;
+        if (!reme_stub::config_from_environment(g_config, error))
+          fprintf(stderr, "reme_stub: %s\n", error.c_str());
+        g_config_loaded = true;
+      }
+    }
+    *c = new _reme_context();
+    g_live_contexts.ref();
+    return REME_ERROR_SUCCESS;
+  }
+
+  reme_error_t reme_context_destroy(reme_context_t *c) {
+    if (!c || !*c)
+      return REME_ERROR_INVALID_HANDLE;
+    g_live_objects.fetchAndAddOrdered(-(int)(*c)->objects.size());
+    delete *c;
+    *c = 0;
+    g_live_contexts.deref();
+    return REME_ERROR_SUCCESS;
+  }
+
+  reme_error_t reme_context_compile(reme_context_t c) {
+    simulate(reme_stub::COMPILE);
+    return c ? REME_ERROR_SUCCESS : REME_ERROR_INVALID_HANDLE;
+  }
+
+  reme_error_t reme_context_get_version(reme_context_t c, const char **version, int *length) {
+    *version = version_string;
+    *length = (int)strlen(version_string);
+    return REME_ERROR_SUCCESS;
+  }
+
+  reme_error_t reme_context_set_log_callback(reme_context_t c, reme_log_callback_t f, void *user_data) {
+    STUB_LOCK(c);
+    c->log = f;
+    c->log_user_data = user_data;
+    return REME_ERROR_SUCCESS;
+  }
+
+  reme_error_t reme_context_bind_reconstruction_options(reme_context_t c, reme_options_t o) {
+    return bind(c, o, RECONSTRUCTION, 0);
+  }
+
+  reme_error_t reme_context_bind_opencl_info(reme_context_t c, reme_options_t o) {
+    return bind(c, o, OPENCL_INFO, 0);
+  }
+
+  // ==================== options ====================
+
+  reme_error_t reme_options_create(reme_context_t c, reme_options_t *o) {
+    return create(c, OPTIONS, o);
+  }
+
+  reme_error_t reme_options_destroy(reme_context_t c, reme_options_t *o) {
+    return destroy(c, OPTIONS, o);
+  }
+
+  reme_error_t reme_options_set(reme_context_t c, reme_options_t o, const char *field_name, const char *value) {
+    STUB_LOCK(c);
+    object *opt = find(c, o, OPTIONS);
+    values_t *v = opt ? bound_values(c, opt) : 0;
+    if (!v)
+      return REME_ERROR_INVALID_HANDLE;
+    (*v)[field_name] = value;
+    return REME_ERROR_SUCCESS;
+  }
+
+  reme_error_t reme_options_get_int(reme_context_t c, reme_options_t o, const char *field_name, int *value) {
+    STUB_LOCK(c);
+    object *opt = find(c, o, OPTIONS);
+    values_t *v = opt ? bound_values(c, opt) : 0;
+    if (!v || v->find(field_name) == v->end())
+      return REME_ERROR_UNSPECIFIED;
+    *value = atoi((*v)[field_name].c_str());
+    return REME_ERROR_SUCCESS;
+  }
+
+  reme_error_t reme_options_get_bool(reme_context_t c, reme_options_t o, const char *field_name, bool *value) {
+    STUB_LOCK(c);
+    object *opt = find(c, o, OPTIONS);
+    values_t *v = opt ? bound_values(c, opt) : 0;
+    if (!v || v->find(field_name) == v->end())
+      return REME_ERROR_UNSPECIFIED;
+    *value = (*v)[field_name] == "true";
+    return REME_ERROR_SUCCESS;
+  }
+
+  reme_error_t reme_options_set_bytes(reme_context_t c, reme_options_t o, const void *bytes, int length) {
+    STUB_LOCK(c);
+    object *opt = find(c, o, OPTIONS);
+    if (!opt)
+      return REME_ERROR_INVALID_HANDLE;
+    opt->bytes.assign((const char*)bytes, length);
+    if (opt->binding == DECIMATION) {
+      object *s = find(c, opt->target, SURFACE);
+      if (s)
+        s->max_faces = read_field_1(opt->bytes, 100000);
+    }
+    return REME_ERROR_SUCCESS;
+  }
+
+  reme_error_t reme_options_get_bytes(reme_context_t c, reme_options_t o, const void **bytes, int *length) {
+    STUB_LOCK(c);
+    object *opt = find(c, o, OPTIONS);
+    values_t *v = opt ? bound_values(c, opt) : 0;
+    if (!v)
+      return REME_ERROR_INVALID_HANDLE;
+
+    // Empty protobuf messages for info bindings, a text dump otherwise
+    opt->bytes.clear();
+    if (opt->binding != OPENCL_INFO && opt->binding != HARDWARE_HASHES) {
+      std::stringstream ss;
+      for (values_t::const_iterator i = v->begin(); i != v->end(); ++i)
+        ss << i->first << ": " << i->second << "\n";
+      opt->bytes = ss.str();
+    }
+    *bytes = opt->bytes.data();
+    *length = (int)opt->bytes.size();
+    return REME_ERROR_SUCCESS;
+  }
+
+  reme_error_t reme_options_load_from_file(reme_context_t c, reme_options_t o, const char *filename) {
+    std::ifstream f(filename);
+    return f.good() ? REME_ERROR_SUCCESS : REME_ERROR_FILE_ERROR;
+  }
+
+  // ==================== license ====================
+
+  reme_error_t reme_license_create(reme_context_t c, reme_license_t *l) {
+    return create(c, LICENSE, l);
+  }
+
+  reme_error_t reme_license_destroy(reme_context_t c, reme_license_t *l) {
+    return destroy(c, LICENSE, l);
+  }
+
+  reme_error_t reme_license_authenticate(reme_context_t c, reme_license_t l, const char *license_file) {
+    return (license_file && *license_file) ? REME_ERROR_SUCCESS : REME_ERROR_INVALID_LICENSE;
+  }
+
+  reme_error_t reme_license_bind_hardware_hashes(reme_context_t c, reme_license_t l, reme_options_t o) {
+    return bind(c, o, HARDWARE_HASHES, l);
+  }
+
+  // ==================== sensor ====================
+
+  reme_error_t reme_sensor_create(reme_context_t c, const char *driver, bool require_can_open, reme_sensor_t *s) {
+    reme_error_t e = create(c, SENSOR, s);
+    if (REME_SUCCESS(e)) {
+      QMutexLocker lock(&c->m);
+      object *sensor = find(c, *s, SENSOR);
+      sensor->driver = driver;
+      sensor_defaults(*sensor);
+    }
+    return e;
+  }
+
+  reme_error_t reme_sensor_destroy(reme_context_t c, reme_sensor_t *s) {
+    return destroy(c, SENSOR, s);
+  }
+
+  reme_error_t reme_sensor_open(reme_context_t c, reme_sensor_t s) {
+    simulate(reme_stub::SENSOR_OPEN);
+    STUB_LOCK(c);
+    object *sensor = find(c, s, SENSOR);
+    if (!sensor)
+      return REME_ERROR_INVALID_HANDLE;
+    sensor->open = true;
+    return REME_ERROR_SUCCESS;
+  }
+
+  reme_error_t reme_sensor_bind_capture_options(reme_context_t c, reme_sensor_t s, reme_options_t o) {
+    return bind(c, o, CAPTURE, s);
+  }
+
+  reme_error_t reme_sensor_is_image_supported(reme_context_t c, reme_sensor_t s, reme_sensor_image_t it, bool *result) {
+    *result = true;
+    return REME_ERROR_SUCCESS;
+  }
+
+  reme_error_t reme_sensor_grab(reme_context_t c, reme_sensor_t s) {
+    simulate(reme_stub::GRAB);
+    STUB_LOCK(c);
+    object *sensor = find(c, s, SENSOR);
+    if (!sensor || !sensor->open)
+      return REME_ERROR_UNSPECIFIED;
+    sensor->frame++;
+    return REME_ERROR_SUCCESS;
+  }
+
+  reme_error_t reme_sensor_prepare_image(reme_context_t c, reme_sensor_t s, reme_sensor_image_t it) {
+    STUB_LOCK(c);
+    return find(c, s, SENSOR) ? REME_ERROR_SUCCESS : REME_ERROR_INVALID_HANDLE;
+  }
+
+  reme_error_t reme_sensor_get_image(reme_context_t c, reme_sensor_t s, reme_sensor_image_t it, reme_image_t i) {
+    simulate(reme_stub::GET_IMAGE);
+    STUB_LOCK(c);
+    object *sensor = find(c, s, SENSOR);
+    object *img = find(c, i, IMAGE);
+    if (!sensor || !img)
+      return REME_ERROR_INVALID_HANDLE;
+    fill_image(*img, *sensor, it);
+    return REME_ERROR_SUCCESS;
+  }
+
+  reme_error_t reme_sensor_track_position(reme_context_t c, reme_sensor_t s) {
+    simulate(reme_stub::TRACK);
+    const int lose_every = current_config().lose_track_every;
+    STUB_LOCK(c);
+    object *sensor = find(c, s, SENSOR);
+    if (!sensor)
+      return REME_ERROR_INVALID_HANDLE;
+    if (lose_every > 0 && sensor->frame % lose_every == 0)
+      return REME_ERROR_TRACK_LOST;
+    return REME_ERROR_SUCCESS;
+  }
+
+  reme_error_t reme_sensor_get_position(reme_context_t c, reme_sensor_t s, float *coordinates) {
+    STUB_LOCK(c);
+    object *sensor = find(c, s, SENSOR);
+    if (!sensor)
+      return REME_ERROR_INVALID_HANDLE;
+    // Identity rotation, the sensor moves one millimeter per frame along x
+    for (int i = 0; i < 16; ++i)
+      coordinates[i] = (i % 5 == 0) ? 1.f : 0.f;
+    coordinates[3] = (float)sensor->frame;
+    return REME_ERROR_SUCCESS;
+  }
+
+  reme_error_t reme_sensor_update_volume(reme_context_t c, reme_sensor_t s) {
+    simulate(reme_stub::UPDATE_VOLUME);
+    STUB_LOCK(c);
+    return find(c, s, SENSOR) ? REME_ERROR_SUCCESS : REME_ERROR_INVALID_HANDLE;
+  }
+
+  reme_error_t reme_sensor_set_trackhint(reme_context_t c, reme_sensor_t s, reme_sensor_trackhint_t hint) {
+    return REME_ERROR_SUCCESS;
+  }
+
+  reme_error_t reme_sensor_reset(reme_context_t c, reme_sensor_t s) {
+    STUB_LOCK(c);
+    object *sensor = find(c, s, SENSOR);
+    if (!sensor)
+      return REME_ERROR_INVALID_HANDLE;
+    sensor->frame = 0;
+    return REME_ERROR_SUCCESS;
+  }
+
+  // ==================== image ====================
+
+  reme_error_t reme_image_create(reme_context_t c, reme_image_t *i) {
+    return create(c, IMAGE, i);
+  }
+
+  reme_error_t reme_image_destroy(reme_context_t c, reme_image_t *i) {
+    return destroy(c, IMAGE, i);
+  }
+
+  reme_error_t reme_image_get_bytes(reme_context_t c, reme_image_t i, const void **bytes, int *length) {
+    STUB_LOCK(c);
+    object *img = find(c, i, IMAGE);
+    if (!img)
+      return REME_ERROR_INVALID_HANDLE;
+    *bytes = img->data.empty() ? 0 : &img->data[0];
+    *length = (int)img->data.size();
+    return REME_ERROR_SUCCESS;
+  }
+
+  reme_error_t reme_image_get_mutable_bytes(reme_context_t c, reme_image_t i, void **bytes, int *length) {
+    STUB_LOCK(c);
+    object *img = find(c, i, IMAGE);
+    if (!img)
+      return REME_ERROR_INVALID_HANDLE;
+    *bytes = img->data.empty() ? 0 : &img->data[0];
+    *length = (int)img->data.size();
+    return REME_ERROR_SUCCESS;
+  }
+
+  reme_error_t reme_image_get_info(reme_context_t c, reme_image_t i, int *width, int *height, int *num_channels, int *num_bytes_per_channel, int *row_stride) {
+    STUB_LOCK(c);
+    object *img = find(c, i, IMAGE);
+    if (!img)
+      return REME_ERROR_INVALID_HANDLE;
+    *width = img->width;
+    *height = img->height;
+    *num_channels = img->channels;
+    *num_bytes_per_channel = img->bytes_per_channel;
+    *row_stride = img->width * img->channels * img->bytes_per_channel;
+    return REME_ERROR_SUCCESS;
+  }
+
+  // ==================== volume ====================
+
+  reme_error_t reme_volume_create(reme_context_t c, reme_volume_t *v) {
+    return create(c, VOLUME, v);
+  }
+
+  reme_error_t reme_volume_destroy(reme_context_t c, reme_volume_t *v) {
+    return destroy(c, VOLUME, v);
+  }
+
+  reme_error_t reme_volume_reset(reme_context_t c, reme_volume_t v) {
+    STUB_LOCK(c);
+    return find(c, v, VOLUME) ? REME_ERROR_SUCCESS : REME_ERROR_INVALID_HANDLE;
+  }
+
+  // ==================== surface ====================
+
+  reme_error_t reme_surface_create(reme_context_t c, reme_surface_t *s) {
+    return create(c, SURFACE, s);
+  }
+
+  reme_error_t reme_surface_destroy(reme_context_t c, reme_surface_t *s) {
+    return destroy(c, SURFACE, s);
+  }
+
+  reme_error_t reme_surface_bind_generation_options(reme_context_t c, reme_surface_t s, reme_options_t o) {
+    return bind(c, o, GENERATION, s);
+  }
+
+  reme_error_t reme_surface_bind_decimation_options(reme_context_t c, reme_surface_t s, reme_options_t o) {
+    return bind(c, o, DECIMATION, s);
+  }
+
+  reme_error_t reme_surface_generate(reme_context_t c, reme_surface_t s, reme_volume_t v) {
+    simulate(reme_stub::GENERATE_SURFACE);
+    const int num_faces = current_config().mesh_faces;
+    STUB_LOCK(c);
+    object *surface = find(c, s, SURFACE);
+    if (!surface || !find(c, v, VOLUME))
+      return REME_ERROR_INVALID_HANDLE;
+    generate_mesh(*surface, num_faces);
+    return REME_ERROR_SUCCESS;
+  }
+
+  reme_error_t reme_surface_decimate(reme_context_t c, reme_surface_t s) {
+    simulate(reme_stub::DECIMATE);
+    STUB_LOCK(c);
+    object *surface = find(c, s, SURFACE);
+    if (!surface)
+      return REME_ERROR_INVALID_HANDLE;
+    if ((int)surface->faces.size() / 3 > surface->max_faces)
+      generate_mesh(*surface, surface->max_faces);
+    return REME_ERROR_SUCCESS;
+  }
+
+  reme_error_t reme_surface_get_points(reme_context_t c, reme_surface_t s, const float **coordinates, int *length) {
+    STUB_LOCK(c);
+    object *surface = find(c, s, SURFACE);
+    if (!surface)
+      return REME_ERROR_INVALID_HANDLE;
+    *coordinates = surface->points.empty() ? 0 : &surface->points[0];
+    *length = (int)surface->points.size();
+    return REME_ERROR_SUCCESS;
+  }
+
+  reme_error_t reme_surface_get_normals(reme_context_t c, reme_surface_t s, const float **coordinates, int *length) {
+    STUB_LOCK(c);
+    object *surface = find(c, s, SURFACE);
+    if (!surface)
+      return REME_ERROR_INVALID_HANDLE;
+    *coordinates = surface->normals.empty() ? 0 : &surface->normals[0];
+    *length = (int)surface->normals.size();
+    return REME_ERROR_SUCCESS;
+  }
+
+  reme_error_t reme_surface_get_triangles(reme_context_t c, reme_surface_t s, const unsigned **indices, int *length) {
+    STUB_LOCK(c);
+    object *surface = find(c, s, SURFACE);
+    if (!surface)
+      return REME_ERROR_INVALID_HANDLE;
+    *indices = surface->faces.empty() ? 0 : &surface->faces[0];
+    *length = (int)surface->faces.size();
+    return REME_ERROR_SUCCESS;
+  }
+
+  reme_error_t reme_surface_transform(reme_context_t c, reme_surface_t s, const float *transform) {
+    STUB_LOCK(c);
+    return find(c, s, SURFACE) ? REME_ERROR_SUCCESS : REME_ERROR_INVALID_HANDLE;
+  }
+
+  reme_error_t reme_surface_save_to_file(reme_context_t c, reme_surface_t s, const char *filename) {
+    simulate(reme_stub::SAVE);
+    STUB_LOCK(c);
+    object *surface = find(c, s, SURFACE);
+    if (!surface)
+      return REME_ERROR_INVALID_HANDLE;
+
+    const std::string path(filename);
+    const bool ply = path.size() > 4 && path.compare(path.size() - 4, 4, ".ply") == 0;
+    std::ofstream f(filename, ply ? std::ios::binary : std::ios::out);
+    if (!f.good())
+      return REME_ERROR_FILE_ERROR;
+
+    const size_t num_points = surface->points.size() / 4;
+    const size_t num_faces = surface->faces.size() / 3;
+    if (ply) {
+      f << "ply\nformat binary_little_endian 1.0\n"
+        << "element vertex " << num_points << "\n"
+        << "property float x\nproperty float y\nproperty float z\n"
+        << "property float nx\nproperty float ny\nproperty float nz\n"
+        << "element face " << num_faces << "\n"
+        << "property list uchar int vertex_indices\nend_header\n";
+      for (size_t i = 0; i < num_points; ++i) {
+        f.write((const char*)&surface->points[i*4], 3 * sizeof(float));
+        f.write((const char*)&surface->normals[i*4], 3 * sizeof(float));
+      }
+      for (size_t i = 0; i < num_faces; ++i) {
+        const unsigned char n = 3;
+        f.write((const char*)&n, 1);
+        f.write((const char*)&surface->faces[i*3], 3 * sizeof(unsigned));
+      }
+    } else {
+      for (size_t i = 0; i < num_points; ++i)
+        f << "v " << surface->points[i*4] << " " << surface->points[i*4+1] << " " << surface->points[i*4+2] << "\n";
+      for (size_t i = 0; i < num_faces; ++i)
+        f << "f " << surface->faces[i*3] + 1 << " " << surface->faces[i*3+1] + 1 << " " << surface->faces[i*3+2] + 1 << "\n";
+    }
+    return f.good() ? REME_ERROR_SUCCESS : REME_ERROR_FILE_ERROR;
+  }
+
+  // ==================== calibration ====================
+
+  reme_error_t reme_calibrator_create(reme_context_t c, reme_calibrator_t *cb) {
+    return create(c, CALIBRATOR, cb);
+  }
+
+  reme_error_t reme_calibrator_destroy(reme_context_t c, reme_calibrator_t *cb) {
+    return destroy(c, CALIBRATOR, cb);
+  }
+
+  // ==================== transform ====================
+
+  reme_error_t reme_transform_set_predefined(reme_context_t c, reme_transform_t t, float *mat) {
+    for (int i = 0; i < 16; ++i)
+      mat[i] = (i % 5 == 0) ? 1.f : 0.f;
+    return REME_ERROR_SUCCESS;
+  }
+}
@@ -0,0 +1,60 @@
+// Configuration and introspection of the reme_stub SDK stand-in.
+//
+// The stub produces deterministic synthetic frames and meshes and can delay
+// selected calls to mimic the timing of a real device. Settings are read from
+// the environment when the first context is created and can be changed at 
+// runtime through set_config:
+//
+//   REME_STUB_DEPTH_SIZE=640x480
+//   REME_STUB_AUX_SIZE=640x480
+//   REME_STUB_MESH_FACES=200000
+//   REME_STUB_LOSE_TRACK_EVERY=0
+//   REME_STUB_LATENCY_US=grab=33000,compile=1500000,generate=250000
+
+#pragma once
+
+#include <string>
+
+namespace reme_stub {
+
+  /** Calls with configurable latency */
+  enum call_t { 
+    COMPILE, 
+    SENSOR_OPEN, 
+    GRAB, 
+    TRACK, 
+    UPDATE_VOLUME, 
+    GET_IMAGE,
+    GENERATE_SURFACE, 
+    DECIMATE, 
+    SAVE,
+    NUM_CALLS 
+  };
+
+  struct config {
+    config();
+
+    int depth_width, depth_height;
+    int aux_width, aux_height;
+    /** Approximate number of triangles of generated surfaces */
+    int mesh_faces;
+    /** Report a tracking failure every n-th frame, 0 disables */
+    int lose_track_every;
+    /** Delay per call in microseconds */
+    int latency_us[NUM_CALLS];
+  };
+
+  config get_config();
+  void set_config(const config &c);
+  /** Parses REME_STUB_* variables into c, returns false on malformed values */
+  bool config_from_environment(config &c, std::string &error);
+
+  /** Number of contexts currently alive */
+  int live_contexts();
+  /** Number of objects (options, sensors, images, ...) alive in all contexts */
+  int live_objects();
+  /** Number of objects created since process start */
+  int created_objects();
+  /** Number of times call was executed since process start */
+  int num_calls(call_t call);
+}
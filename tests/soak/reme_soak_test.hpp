@@ -0,0 +1,308 @@
+#include "reme_resource_manager.h"
+#include "frame_grabber.h"
+#include "kernel_cache.h"
+#include "log_sink.h"
+#include "session_file.h"
+#include "settings.h"
+#include "reme_stub.h"
+
+#include <QObject>
+#include <QtTest>
+#include <QtCore>
+#include <QElapsedTimer>
+#include <QVector>
+#include <QDir>
+
+#include <memory>
+#include <algorithm>
+#include <iostream>
+
+#if _WIN32
+  #define WIN32_LEAN_AND_MEAN
+  #include <windows.h>
+  #include <psapi.h>
+#else
+  #include <unistd.h>
+  #include <cstdio>
+#endif
+
+using namespace ReconstructMeGUI;
+
+/** Resident set size of this process in megabytes */
+static double current_rss_mb() {
+#if _WIN32
+  PROCESS_MEMORY_COUNTERS pmc;
+  if (!GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc)))
+    return 0;
+  return pmc.WorkingSetSize / (1024.0 * 1024.0);
+#else
+  long pages = 0, resident = 0;
+  FILE *f = fopen("/proc/self/statm", "r");
+  if (!f)
+    return 0;
+  if (fscanf(f, "%ld %ld", &pages, &resident) != 2)
+    resident = 0;
+  fclose(f);
+  return resident * (double)sysconf(_SC_PAGESIZE) / (1024.0 * 1024.0);
+#endif
+}
+
+/** Least squares slope of samples over their index */
+static double slope(const QVector<double> &y) {
+  const int n = y.size();
+  if (n < 2)
+    return 0;
+  double sx = 0, sy = 0, sxx = 0, sxy = 0;
+  for (int i = 0; i < n; ++i) {
+    sx += i; sy += y[i]; sxx += (double)i * i; sxy += i * y[i];
+  }
+  return (n * sxy - sx * sy) / (n * sxx - sx * sx);
+}
+
+static double median(QVector<double> v) {
+  if (v.isEmpty())
+    return 0;
+  std::sort(v.begin(), v.end());
+  return v[v.size() / 2];
+}
+
+static int env_int(const char *name, int fallback) {
+  QByteArray v = qgetenv(name);
+  return v.isEmpty() ? fallback : v.toInt();
+}
+
+/** Runs scanning cycles from within the grab loop of frame_grabber.
+ *
+ *  Each cycle starts scanning, processes a fixed number of frames, stops 
+ *  scanning, generates a surface and resets the volume. Memory, live SDK
+ *  objects and cycle latency are sampled after every cycle.
+ */
+class soak_driver : public QObject
+{
+  Q_OBJECT
+
+public:
+  soak_driver(std::shared_ptr<reme_resource_manager> rm, std::shared_ptr<frame_grabber> fg, int cycles, int frames_per_cycle) :
+    _rm(rm), _fg(fg), _cycles(cycles), _frames_per_cycle(frames_per_cycle), _cycle(0), _frame(0), _num_faces(0)
+  {}
+
+  int completed() const { return _cycle; }
+  int num_faces() const { return _num_faces; }
+
+  QVector<double> latency_ms;
+  QVector<double> rss_mb;
+  QVector<double> live_objects;
+
+public slots:
+  void frame() {
+    if (_cycle >= _cycles)
+      return;
+
+    if (_frame == 0) {
+      _timer.start();
+      _rm->start_scanning();
+    }
+
+    if (++_frame < _frames_per_cycle)
+      return;
+
+    _rm->stop_scanning();
+    _rm->generate_surface(0.5f);
+    _rm->reset_volume();
+
+    latency_ms.push_back(_timer.nsecsElapsed() / 1e6);
+    rss_mb.push_back(current_rss_mb());
+    live_objects.push_back(reme_stub::live_objects());
+
+    _frame = 0;
+    if (++_cycle == _cycles)
+      _fg->stop();
+  }
+
+  void surface(bool has_surface, const float *, int, const float *, int, const unsigned *, int num_faces) {
+    _num_faces = has_surface ? num_faces : 0;
+  }
+
+private:
+  std::shared_ptr<reme_resource_manager> _rm;
+  std::shared_ptr<frame_grabber> _fg;
+  int _cycles, _frames_per_cycle;
+  int _cycle, _frame;
+  int _num_faces;
+  QElapsedTimer _timer;
+};
+
+/** Scans a few frames, generates a surface and saves a session from within the grab loop */
+class session_driver : public QObject
+{
+  Q_OBJECT
+
+public:
+  session_driver(std::shared_ptr<reme_resource_manager> rm, std::shared_ptr<frame_grabber> fg, const QString &file_name, int frames) :
+    _rm(rm), _fg(fg), _file_name(file_name), _frames(frames), _frame(0), saved(false)
+  {}
+
+  bool saved;
+
+public slots:
+  void frame() {
+    if (saved)
+      return;
+
+    if (_frame == 0) {
+      _rm->start_scanning();
+      _rm->new_log_message(REME_LOG_SEVERITY_INFO, "Session test scan");
+    }
+
+    if (++_frame < _frames)
+      return;
+
+    _rm->stop_scanning();
+    _rm->generate_surface(0.5f);
+    _rm->save_session(_file_name, QByteArray());
+    saved = true;
+    _fg->stop();
+  }
+
+private:
+  std::shared_ptr<reme_resource_manager> _rm;
+  std::shared_ptr<frame_grabber> _fg;
+  QString _file_name;
+  int _frames, _frame;
+};
+
+/** Long-running scan cycles through reme_resource_manager and frame_grabber.
+ *
+ *  Fails when live SDK objects grow, or when memory or cycle latency trend 
+ *  upward beyond a tolerance. Tunable through the environment:
+ *  REME_SOAK_CYCLES, REME_SOAK_FRAMES, REME_SOAK_RSS_TOLERANCE_MB, 
+ *  REME_SOAK_LATENCY_TOLERANCE_PCT and REME_SOAK_CSV (per-cycle samples).
+ */
+class reme_soak_test : public QObject
+{
+  Q_OBJECT
+
+private slots:
+  void log_sink_sync();
+  void session_save();
+  void scan_cycles();
+};
+
+void reme_soak_test::log_sink_sync()
+{
+  log_sink sink(QDir::temp().absoluteFilePath("reme_soak/logs"), "sync");
+  sink.start();
+
+  // sync must return once the drained records are on disk, also after the queue ran empty
+  for (int i = 1; i <= 3; ++i) {
+    sink.push(REME_LOG_SEVERITY_INFO, QString("message %1").arg(i));
+    sink.sync();
+    QCOMPARE(sink.written(), i);
+  }
+  sink.stop();
+}
+
+void reme_soak_test::session_save()
+{
+  QDir().mkpath(QDir::temp().absoluteFilePath("reme_soak"));
+  const QString file_name = QDir::temp().absoluteFilePath("reme_soak/session.rmsession");
+  QFile::remove(file_name);
+
+  std::shared_ptr<reme_resource_manager> rm(new reme_resource_manager());
+  rm->override_setting(sensor_path_tag, "stub");
+  rm->override_setting(config_path_tag, config_path_default_tag);
+  rm->override_setting(license_file_tag, "stub.lic");
+
+  std::shared_ptr<frame_grabber> fg(new frame_grabber(rm));
+  rm->set_frame_grabber(fg);
+  fg->request(REME_IMAGE_DEPTH);
+
+  session_driver driver(rm, fg, file_name, 10);
+  driver.connect(fg.get(), SIGNAL(frames_updated()), SLOT(frame()));
+
+  rm->initialize();
+
+  QVERIFY(driver.saved);
+
+  session_reader r;
+  QVERIFY(r.open(file_name));
+  QVERIFY(r.find(session_section::MESH) >= 0);
+  QVERIFY(r.find(session_section::LOG) >= 0);
+}
+
+void reme_soak_test::scan_cycles()
+{
+  const int cycles = env_int("REME_SOAK_CYCLES", 2000);
+  const int frames = env_int("REME_SOAK_FRAMES", 5);
+  const double rss_tolerance_mb = env_int("REME_SOAK_RSS_TOLERANCE_MB", 8);
+  const double latency_tolerance = env_int("REME_SOAK_LATENCY_TOLERANCE_PCT", 25) / 100.0;
+  
+  std::shared_ptr<reme_resource_manager> rm(new reme_resource_manager());
+  rm->override_setting(sensor_path_tag, "stub");
+  rm->override_setting(config_path_tag, config_path_default_tag);
+  rm->override_setting(license_file_tag, "stub.lic");
+
+  std::shared_ptr<frame_grabber> fg(new frame_grabber(rm));
+  rm->set_frame_grabber(fg);
+  fg->request(REME_IMAGE_AUX);
+  fg->request(REME_IMAGE_DEPTH);
+  fg->request(REME_IMAGE_VOLUME);
+
+  soak_driver driver(rm, fg, cycles, frames);
+  driver.connect(fg.get(), SIGNAL(frames_updated()), SLOT(frame()));
+  driver.connect(rm.get(), SIGNAL(surface(bool, const float *, int, const float *, int, const unsigned *, int)), SLOT(surface(bool, const float *, int, const float *, int, const unsigned *, int)));
+
+  // Grabbing starts on sdk_initialized and runs until the driver stops it
+  rm->initialize();
+
+  QCOMPARE(driver.completed(), cycles);
+  QVERIFY(driver.num_faces() > 0);
+
+  QByteArray csv = qgetenv("REME_SOAK_CSV");
+  if (!csv.isEmpty()) {
+    QFile f(csv);
+    if (f.open(QIODevice::WriteOnly | QIODevice::Text)) {
+      QTextStream ts(&f);
+      ts << "cycle,latency_ms,rss_mb,live_objects\n";
+      for (int i = 0; i < cycles; ++i)
+        ts << i << "," << driver.latency_ms[i] << "," << driver.rss_mb[i] << "," << driver.live_objects[i] << "\n";
+    }
+  }
+
+  // Skip warm-up cycles that fill pools and caches
+  const int warmup = std::max(10, cycles / 10);
+  QVERIFY2(cycles > warmup + 10, "Too few cycles for trend analysis");
+
+  QVector<double> latency = driver.latency_ms.mid(warmup);
+  QVector<double> rss = driver.rss_mb.mid(warmup);
+  QVector<double> live = driver.live_objects.mid(warmup);
+  const int n = latency.size();
+
+  const double live_min = *std::min_element(live.begin(), live.end());
+  const double live_max = *std::max_element(live.begin(), live.end());
+  const double rss_growth = slope(rss) * n;
+  const double latency_growth = slope(latency) * n;
+  const double latency_median = median(latency);
+
+  std::cout << "soak: " << cycles << " cycles, " 
+            << "live objects " << live_min << ".." << live_max << ", "
+            << "rss growth " << rss_growth << " MB, "
+            << "median cycle " << latency_median << " ms, "
+            << "latency growth " << latency_growth << " ms" << std::endl;
+
+  QVERIFY2(live_max == live_min, "Live SDK objects grow across cycles");
+  QVERIFY2(rss_growth <= rss_tolerance_mb, "Resident memory trends upward");
+  QVERIFY2(latency_growth <= latency_tolerance * latency_median, "Cycle latency trends upward");
+}
+
+int main(int argc, char *argv[])
+{
+  QCoreApplication app(argc, argv);
+  
+  // Keep settings and kernel cache of the test away from the user's
+  QSettings::setPath(QSettings::IniFormat, QSettings::UserScope, QDir::temp().absoluteFilePath("reme_soak"));
+  kernel_cache(kernel_cache::default_root()).export_environment();
+
+  reme_soak_test t;
+  return QTest::qExec(&t, argc, argv);
+}